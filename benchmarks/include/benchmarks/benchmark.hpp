@@ -0,0 +1,109 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace benchmarks {
+/**
+ * \brief Outcome of a single benchmark run.
+ */
+struct measurement {
+	size_t operations {0};
+	std::chrono::nanoseconds duration {};
+	std::vector<std::chrono::nanoseconds> latencies {};	   // sorted, only filled in by `measure_latency`.
+	size_t allocations {0};	   // allocations made by the measured code, 0 when the benchmark does not count them.
+	size_t bytes {0};		   // bytes moved by the measured code, 0 when the benchmark does not count them.
+
+	double operations_per_second() const noexcept {
+		return (duration.count() == 0) ? 0.0 : (double)operations * 1e9 / (double)duration.count();
+	}
+
+	/**
+	 * \brief Latency of the given percentile (in the range [0, 1]) of the operations.
+	 */
+	std::chrono::nanoseconds percentile(double value) const noexcept {
+		if(latencies.empty())
+			return {};
+		return latencies[std::min(latencies.size() - 1, (size_t)(value * (double)latencies.size()))];
+	}
+};
+
+struct entry {
+	std::string name {};
+	std::function<measurement()> fn {};
+};
+
+inline std::vector<entry>& registry() {
+	static std::vector<entry> entries {};
+	return entries;
+}
+
+/**
+ * \brief Registers a benchmark, to be used as `auto name = benchmark("name") = [] { ... };`
+ */
+struct benchmark {
+	benchmark(std::string name) : m_Name(std::move(name)) {}
+
+	template <typename Fn>
+	int operator=(Fn&& fn) {
+		registry().emplace_back(std::move(m_Name), std::forward<Fn>(fn));
+		return 0;
+	}
+
+  private:
+	std::string m_Name {};
+};
+
+/**
+ * \brief Times the invocation of `fn`, which is expected to perform `operations` operations.
+ */
+template <typename Fn>
+measurement measure(size_t operations, Fn&& fn) {
+	auto begin = std::chrono::steady_clock::now();
+	fn();
+	auto end = std::chrono::steady_clock::now();
+	return {operations, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)};
+}
+
+/**
+ * \brief Times every invocation of `fn(index)` individually, for `operations` invocations.
+ */
+template <typename Fn>
+measurement measure_latency(size_t operations, Fn&& fn) {
+	measurement result {operations};
+	result.latencies.reserve(operations);
+	for(size_t index = 0; index < operations; ++index) {
+		auto begin = std::chrono::steady_clock::now();
+		fn(index);
+		auto end = std::chrono::steady_clock::now();
+		result.latencies.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin));
+		result.duration += result.latencies.back();
+	}
+	std::sort(result.latencies.begin(), result.latencies.end());
+	return result;
+}
+
+/**
+ * \brief Prevents the compiler from optimizing away the computation of `value`.
+ */
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(_MSC_VER)
+	// msvc has no inline assembly on x64, the value escapes through a volatile sink instead, and the barrier makes sure
+	// it was written to memory before.
+	static char const* volatile sink {nullptr};
+	sink = reinterpret_cast<char const*>(&value);
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+}	 // namespace benchmarks
@@ -0,0 +1,90 @@
+#include <benchmarks/benchmark.hpp>
+#include <cstdio>
+
+namespace {
+/**
+ * \brief Writes `value` as a JSON string, benchmark names only need quotes and backslashes escaped.
+ */
+void print_json_string(std::string_view value) {
+	std::putchar('"');
+	for(auto c : value) {
+		if(c == '"' || c == '\\')
+			std::putchar('\\');
+		std::putchar(c);
+	}
+	std::putchar('"');
+}
+
+void print_table(std::string const& name, benchmarks::measurement const& result) {
+	std::printf("%-64s %12zu ops %10.3f ms %14.0f ops/s\n",
+				name.c_str(),
+				result.operations,
+				(double)result.duration.count() / 1e6,
+				result.operations_per_second());
+	if(!result.latencies.empty())
+		std::printf("%-64s p50 %8lld ns  p99 %8lld ns  p999 %8lld ns\n",
+					"",
+					(long long)result.percentile(0.5).count(),
+					(long long)result.percentile(0.99).count(),
+					(long long)result.percentile(0.999).count());
+	if(result.allocations != 0)
+		std::printf("%-64s %12zu allocations\n", "", result.allocations);
+	if(result.bytes != 0)
+		std::printf("%-64s %12zu bytes\n", "", result.bytes);
+}
+
+void print_json(std::string const& name, benchmarks::measurement const& result, bool first) {
+	std::printf("%s\n    {\"name\": ", first ? "" : ",");
+	print_json_string(name);
+	std::printf(", \"operations\": %zu, \"duration_ns\": %lld, \"operations_per_second\": %.0f",
+				result.operations,
+				(long long)result.duration.count(),
+				result.operations_per_second());
+	if(!result.latencies.empty())
+		std::printf(", \"p50_ns\": %lld, \"p99_ns\": %lld, \"p999_ns\": %lld",
+					(long long)result.percentile(0.5).count(),
+					(long long)result.percentile(0.99).count(),
+					(long long)result.percentile(0.999).count());
+	if(result.allocations != 0)
+		std::printf(", \"allocations\": %zu", result.allocations);
+	if(result.bytes != 0)
+		std::printf(", \"bytes\": %zu", result.bytes);
+	std::printf("}");
+	std::fflush(stdout);
+}
+}	 // namespace
+
+/**
+ * \brief usage: `psl_benchmarks [--json] [filter]`, only the benchmarks whose name contains the filter are run.
+ * \details By default the results are printed as a table, `--json` prints them as a JSON document instead (of the
+ * form `{"benchmarks": [{"name", "operations", "duration_ns", "operations_per_second", ...}]}`, where the optional
+ * fields are the latency percentiles, the allocation count and the bytes moved), so that the results of different
+ * releases can be compared.
+ */
+int main(int argc, char* argv[]) {
+	std::string_view filter {};
+	bool json {false};
+	for(int i = 1; i < argc; ++i) {
+		if(std::string_view {argv[i]} == "--json")
+			json = true;
+		else
+			filter = argv[i];
+	}
+
+	if(json)
+		std::printf("{\n  \"benchmarks\": [");
+	bool first {true};
+	for(auto& entry : benchmarks::registry()) {
+		if(!filter.empty() && entry.name.find(filter) == std::string::npos)
+			continue;
+		auto result = entry.fn();
+		if(json)
+			print_json(entry.name, result, first);
+		else
+			print_table(entry.name, result);
+		first = false;
+	}
+	if(json)
+		std::printf("\n  ]\n}\n");
+	return 0;
+}
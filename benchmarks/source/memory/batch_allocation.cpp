@@ -0,0 +1,73 @@
+#include <benchmarks/benchmark.hpp>
+#include <psl/memory/monotonic_resource.hpp>
+#include <psl/memory/pool_resource.hpp>
+#include <vector>
+
+using namespace benchmarks;
+
+namespace {
+constexpr size_t nodes		= 1 << 16;
+constexpr size_t iterations = 64;
+
+using shared_allocator_t = psl::allocator<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+using arena_allocator_t	 = psl::allocator<psl::traits::shareable_t<false>, psl::traits::basic_allocation>;
+
+struct node_t {
+	node_t* left {nullptr};
+	node_t* right {nullptr};
+	size_t value {0};
+};
+
+/**
+ * \brief builds a complete binary tree, walks it and tears it down again, either allocating node by node or the whole
+ * tree in one batch.
+ */
+template <bool Batched, typename Allocator, typename Reset>
+measurement build_tree(Allocator allocator, Reset&& reset) {
+	std::vector<node_t*> storage(nodes);
+	return measure(iterations * nodes, [&] {
+		for(size_t iteration = 0; iteration < iterations; ++iteration) {
+			if constexpr(Batched) {
+				allocator.allocate_batch(storage.data(), nodes);
+			} else {
+				for(auto& node : storage) node = allocator.template allocate<node_t>().data;
+			}
+
+			for(size_t i = 0; i < nodes; ++i) {
+				auto* node	= new(storage[i]) node_t {};
+				node->value = i;
+				if(i > 0)
+					((i % 2) ? storage[(i - 1) / 2]->left : storage[(i - 1) / 2]->right) = node;
+			}
+			do_not_optimize(storage[nodes - 1]->value);
+
+			if constexpr(Batched) {
+				allocator.deallocate_batch(storage.data(), nodes);
+			} else {
+				for(auto* node : storage) allocator.deallocate(node);
+			}
+			reset();
+		}
+	});
+}
+
+auto registration = [] {
+	benchmark("pool_resource/build_tree") = [] {
+		psl::pool_resource<> resource {8};
+		return build_tree<false>(shared_allocator_t {&resource}, [] {});
+	};
+	benchmark("pool_resource/build_tree_batch") = [] {
+		psl::pool_resource<> resource {8};
+		return build_tree<true>(shared_allocator_t {&resource}, [] {});
+	};
+	benchmark("monotonic_resource/build_tree") = [] {
+		psl::monotonic_resource<> resource {8, 1 << 22};
+		return build_tree<false>(arena_allocator_t {&resource}, [&] { resource.reset(); });
+	};
+	benchmark("monotonic_resource/build_tree_batch") = [] {
+		psl::monotonic_resource<> resource {8, 1 << 22};
+		return build_tree<true>(arena_allocator_t {&resource}, [&] { resource.reset(); });
+	};
+	return 0;
+}();
+}	 // namespace
@@ -0,0 +1,71 @@
+#include <benchmarks/benchmark.hpp>
+#include <psl/array.hpp>
+#include <psl/memory/stack_resource.hpp>
+
+using namespace benchmarks;
+
+namespace {
+constexpr size_t iterations = 1 << 22;
+constexpr size_t scratch	= 16;
+
+using shared_allocator_t = psl::allocator<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+using stack_allocator_t	 = psl::allocator<psl::traits::shareable_t<false>, psl::traits::basic_allocation>;
+
+/**
+ * \brief allocates and immediately frees a small block, which is dominated by the cost of calling into the resource.
+ */
+template <typename Allocator>
+measurement churn(Allocator allocator) {
+	return measure(iterations, [&] {
+		for(size_t i = 0; i < iterations; ++i) {
+			auto res = allocator.template allocate<std::uint64_t>(64);
+			do_not_optimize(res.data);
+			allocator.deallocate(res.data, 64);
+		}
+	});
+}
+
+/**
+ * \brief a scratch array in a hot function, that is filled and discarded on every call.
+ */
+template <typename Allocator>
+measurement scratch_array(Allocator allocator) {
+	return measure(iterations / scratch, [&] {
+		for(size_t i = 0; i < iterations / scratch; ++i) {
+			psl::array<int, psl::dynamic_extent, psl::settings::array<Allocator, psl::default_t, 0>> values {
+			  allocator};
+			values.reserve(scratch);
+			for(int value = 0; value < (int)scratch; ++value) values.emplace_back(value);
+			do_not_optimize(values[scratch - 1]);
+		}
+	});
+}
+
+auto registration = [] {
+	benchmark("allocator<new_resource>/churn") = [] {
+		psl::new_resource resource {8};
+		return churn(shared_allocator_t {&resource});
+	};
+	benchmark("bound_allocator<new_resource, 8>/churn") = [] {
+		psl::new_resource resource {8};
+		return churn(psl::bound_allocator<psl::new_resource, 8> {&resource});
+	};
+	benchmark("allocator<stack_resource>/churn") = [] {
+		psl::stack_resource<> resource {8, 1 << 20};
+		return churn(stack_allocator_t {&resource});
+	};
+	benchmark("bound_allocator<stack_resource, 8>/churn") = [] {
+		psl::stack_resource<> resource {8, 1 << 20};
+		return churn(psl::bound_allocator<psl::stack_resource<>, 8> {&resource});
+	};
+	benchmark("allocator<stack_resource>/scratch_array") = [] {
+		psl::stack_resource<> resource {8, 1 << 20};
+		return scratch_array(stack_allocator_t {&resource});
+	};
+	benchmark("bound_allocator<stack_resource, 8>/scratch_array") = [] {
+		psl::stack_resource<> resource {8, 1 << 20};
+		return scratch_array(psl::bound_allocator<psl::stack_resource<>, 8> {&resource});
+	};
+	return 0;
+}();
+}	 // namespace
@@ -0,0 +1,51 @@
+#include <array>
+#include <benchmarks/benchmark.hpp>
+#include <psl/memory/concurrent_pool_resource.hpp>
+#include <thread>
+#include <vector>
+
+using namespace benchmarks;
+
+namespace {
+constexpr size_t block_size	 = 64;
+constexpr size_t iterations	 = 1 << 18;
+constexpr size_t live_blocks = 32;
+
+/**
+ * \brief every thread keeps a small window of live blocks, and continuously frees and allocates in it.
+ */
+template <typename Resource>
+measurement churn(Resource& resource, size_t thread_count) {
+	return measure(iterations * thread_count, [&] {
+		std::vector<std::thread> threads {};
+		for(size_t t = 0; t < thread_count; ++t) {
+			threads.emplace_back([&] {
+				std::array<void*, live_blocks> window {};
+				for(auto& block : window) block = resource.allocate(block_size, 8).data;
+				for(size_t i = 0; i < iterations; ++i) {
+					auto& block = window[i % live_blocks];
+					resource.deallocate(block, block_size, 8);
+					block = resource.allocate(block_size, 8).data;
+					do_not_optimize(block);
+				}
+				for(auto* block : window) resource.deallocate(block, block_size, 8);
+			});
+		}
+		for(auto& thread : threads) thread.join();
+	});
+}
+
+auto registration = [] {
+	for(size_t threads : {1, 4, 8}) {
+		benchmark("new_resource/churn/" + std::to_string(threads) + "_threads") = [threads] {
+			psl::new_resource resource {8};
+			return churn(resource, threads);
+		};
+		benchmark("concurrent_pool_resource/churn/" + std::to_string(threads) + "_threads") = [threads] {
+			psl::concurrent_pool_resource<> resource {8, block_size, 1024};
+			return churn(resource, threads);
+		};
+	}
+	return 0;
+}();
+}	 // namespace
@@ -0,0 +1,64 @@
+#include <benchmarks/benchmark.hpp>
+#include <cstring>
+#include <psl/array.hpp>
+#include <psl/memory/dirty_tracking_resource.hpp>
+#include <random>
+#include <vector>
+
+using namespace benchmarks;
+
+namespace {
+constexpr size_t frames	 = 256;
+constexpr size_t elements = 1 << 20;
+constexpr size_t updates  = 64;	   // sparse writes per frame.
+constexpr size_t atom	  = 64;	   // flush granularity, as the non-coherent atom size of a device.
+
+using allocator_t = psl::allocator<psl::traits::shareable_t<true>,
+								   psl::traits::basic_allocation,
+								   psl::traits::host_writability_t<psl::traits::syncronization::flush>>;
+
+/**
+ * \brief updates a few random elements of a large array every frame, and flushes it to a simulated device copy,
+ * either as a whole buffer or only the ranges that were marked dirty.
+ */
+measurement sparse_updates(bool tracked) {
+	std::vector<std::byte> device(elements * sizeof(float));
+	std::byte* host {nullptr};
+	size_t flushed {0};
+	auto flush = [&](void* location, size_t size) {
+		std::memcpy(device.data() + ((std::byte*)location - host), location, size);
+		flushed += size;
+	};
+	psl::dirty_tracking_resource<> resource {alignof(float), flush, atom};
+	psl::array<float, psl::dynamic_extent, psl::settings::array<allocator_t, psl::default_t, 0>> values {
+	  allocator_t {&resource}};
+	values.resize(elements);
+	host = (std::byte*)&values[0];
+
+	std::mt19937 rng {7};
+	auto result = measure(frames, [&] {
+		for(size_t frame = 0; frame < frames; ++frame) {
+			for(size_t update = 0; update < updates; ++update) {
+				auto index	  = rng() % elements;
+				values[index] = (float)frame;
+				if(tracked)
+					resource.mark_dirty(std::span {&values[index], 1});
+			}
+			if(tracked)
+				resource.flush();
+			else {
+				std::memcpy(device.data(), host, elements * sizeof(float));
+				flushed += elements * sizeof(float);
+			}
+		}
+	});
+	result.bytes = flushed;
+	return result;
+}
+
+auto registration = [] {
+	benchmark("dirty_tracking_resource/sparse_updates/whole_buffer") = [] { return sparse_updates(false); };
+	benchmark("dirty_tracking_resource/sparse_updates/tracked") = [] { return sparse_updates(true); };
+	return 0;
+}();
+}	 // namespace
@@ -0,0 +1,47 @@
+#include <benchmarks/benchmark.hpp>
+#include <psl/array.hpp>
+#include <psl/memory/huge_page_resource.hpp>
+#include <cstdio>
+#include <random>
+
+using namespace benchmarks;
+
+namespace {
+constexpr size_t elements = size_t {64} << 20;	  // 256 MiB of floats
+constexpr size_t lookups  = size_t {1} << 24;
+
+/**
+ * \brief random reads over a large buffer, which is dominated by TLB misses when backed by normal pages.
+ */
+template <typename Resource, typename Fn = void (*)()>
+measurement gather(Resource& resource, Fn&& on_filled = [] {}) {
+	psl::allocator<psl::traits::shareable_t<true>, psl::traits::basic_allocation> allocator {&resource};
+	psl::array<float> buffer {allocator};
+	buffer.resize(elements, 1.0f);
+	on_filled();
+
+	std::minstd_rand rng {42};
+	return measure(lookups, [&] {
+		float sum {0.0f};
+		for(size_t i = 0; i < lookups; ++i) sum += buffer[rng() % elements];
+		do_not_optimize(sum);
+	});
+}
+
+auto registration = [] {
+	benchmark("new_resource/gather") = [] {
+		psl::new_resource resource {alignof(float)};
+		return gather(resource);
+	};
+	benchmark("huge_page_resource/gather") = [] {
+		psl::huge_page_resource<> resource {alignof(float)};
+		return gather(resource, [&resource] {
+			std::fprintf(stderr,
+						 "huge_page_resource: %zu of %zu bytes advised as huge pages\n",
+						 resource.advised_bytes(),
+						 resource.mapped_bytes());
+		});
+	};
+	return 0;
+}();
+}	 // namespace
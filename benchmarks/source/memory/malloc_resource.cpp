@@ -0,0 +1,51 @@
+#include <benchmarks/benchmark.hpp>
+#include <psl/allocator.hpp>
+#include <psl/array.hpp>
+
+using namespace benchmarks;
+
+namespace {
+constexpr size_t iterations = 1 << 14;
+constexpr size_t max_count	= 1000;
+
+/**
+ * \brief fills arrays of up to `max_count` elements one `emplace_back` at a time, and counts how often they had to
+ * reallocate. The resource's reported slack is used as capacity, so fewer reallocations are needed to get there.
+ */
+template <typename Resource, typename Allocator>
+measurement emplace_back() {
+	Resource resource {alignof(int)};
+	size_t allocations {0};
+	auto result = measure(iterations, [&] {
+		for(size_t i = 0; i < iterations; ++i) {
+			psl::array<int, psl::dynamic_extent, psl::settings::array<Allocator, psl::default_t, 0>> values {
+			  Allocator {&resource}};
+			size_t capacity {0};
+			for(int value = 0; value < (int)(1 + i % max_count); ++value) {
+				values.emplace_back(value);
+				if(values.capacity() != capacity) {
+					capacity = values.capacity();
+					++allocations;
+				}
+			}
+			do_not_optimize(values[0]);
+		}
+	});
+	result.allocations = allocations;
+	return result;
+}
+
+auto registration = [] {
+	benchmark("new_resource/emplace_back") = [] {
+		return emplace_back<psl::new_resource,
+							psl::allocator<psl::traits::shareable_t<true>, psl::traits::basic_allocation>>();
+	};
+	benchmark("malloc_resource/emplace_back") = [] {
+		return emplace_back<psl::malloc_resource,
+							psl::allocator<psl::traits::shareable_t<true>,
+										   psl::traits::basic_allocation,
+										   psl::traits::queryable_size_t>>();
+	};
+	return 0;
+}();
+}	 // namespace
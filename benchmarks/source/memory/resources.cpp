@@ -0,0 +1,264 @@
+#include <array>
+#include <benchmarks/benchmark.hpp>
+#include <memory>
+#include <psl/array.hpp>
+#include <psl/memory/buddy_resource.hpp>
+#include <psl/memory/concurrent_pool_resource.hpp>
+#include <psl/memory/huge_page_resource.hpp>
+#include <psl/memory/monotonic_resource.hpp>
+#include <psl/memory/pool_resource.hpp>
+#include <psl/memory/stack_resource.hpp>
+#include <psl/memory/thread_arena_resource.hpp>
+#include <psl/memory/thread_cache_resource.hpp>
+#include <psl/memory/tlsf_resource.hpp>
+#include <psl/memory/virtual_memory_resource.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures every memory resource on the same set of workloads:
+ * - `lifo`: allocates a window of blocks and frees them in reverse order, which every resource supports.
+ * - `random`: keeps a window of live blocks and replaces a random one on every iteration, this is skipped for the
+ *   arena-like resources (those that are recycled through `reset()`) as they don't reclaim individual blocks.
+ * - `construct_destroy` and `construct_n`: object construction through the resource's `psl::allocator`.
+ * - `array_growth`: grows a `psl::array` one element at a time.
+ * The alloc/free loops run over several size distributions, and are repeated on multiple threads for the resources
+ * that are synchronized.
+ */
+using namespace benchmarks;
+
+namespace {
+constexpr size_t iterations			= 1 << 16;
+constexpr size_t window				= 64;
+constexpr size_t alignment			= 8;
+constexpr size_t concurrent_threads = 4;
+constexpr size_t capacity		   = size_t {1} << 28;	  // of the resources that have a fixed capacity.
+
+/**
+ * \brief precomputed request sizes, so that generating them is not part of the measurement.
+ */
+struct distribution_t {
+	char const* name;
+	std::vector<size_t> sizes;
+
+	size_t operator[](size_t index) const noexcept { return sizes[index % sizes.size()]; }
+};
+
+distribution_t make_distribution(char const* name, size_t min, size_t max, size_t large_min = 0, size_t large_max = 0) {
+	std::mt19937_64 rng {1337};
+	distribution_t result {name, std::vector<size_t>(4096)};
+	for(auto& size : result.sizes) {
+		// one in five requests comes from the large range, when there is one.
+		if(large_max != 0 && rng() % 5 == 0)
+			size = large_min + rng() % (large_max - large_min + 1);
+		else
+			size = min + rng() % (max - min + 1);
+	}
+	return result;
+}
+
+std::vector<distribution_t> const& distributions() {
+	static std::vector<distribution_t> values {make_distribution("small", 8, 128),
+											   make_distribution("mixed", 8, 256, 256, 8192),
+											   make_distribution("large", 8192, 256 * 1024)};
+	return values;
+}
+
+template <typename Resource>
+void reset(Resource& resource) {
+	if constexpr(requires { resource.reset(); })
+		resource.reset();
+}
+
+template <typename Resource>
+constexpr bool is_arena = requires(Resource& resource) { resource.reset(); };
+
+/**
+ * \brief the type erased `psl::allocator` that matches the traits of the resource.
+ */
+template <typename... Traits>
+psl::allocator<Traits...> allocator_for(psl::traited_memory_resource<Traits...>* resource) {
+	return psl::allocator<Traits...> {resource};
+}
+
+template <typename Fn>
+measurement run_threads(size_t thread_count, size_t operations, Fn&& fn) {
+	return measure(operations * thread_count, [&] {
+		if(thread_count == 1) {
+			fn(size_t {0});
+			return;
+		}
+		std::vector<std::thread> threads {};
+		for(size_t t = 0; t < thread_count; ++t) threads.emplace_back([&, t] { fn(t); });
+		for(auto& thread : threads) thread.join();
+	});
+}
+
+template <typename Resource>
+measurement lifo(Resource& resource, distribution_t const& distribution, size_t thread_count) {
+	return run_threads(thread_count, iterations, [&](size_t thread) {
+		std::array<void*, window> blocks {};
+		for(size_t round = 0; round < iterations / window; ++round) {
+			auto offset = thread * 7 + round * window;
+			for(size_t i = 0; i < window; ++i) blocks[i] = resource.allocate(distribution[offset + i], alignment).data;
+			do_not_optimize(blocks);
+			for(size_t i = window; i > 0; --i)
+				resource.deallocate(blocks[i - 1], distribution[offset + i - 1], alignment);
+			if(thread_count == 1)
+				reset(resource);
+		}
+	});
+}
+
+template <typename Resource>
+measurement random_replace(Resource& resource, distribution_t const& distribution, size_t thread_count) {
+	return run_threads(thread_count, iterations, [&](size_t thread) {
+		std::array<std::pair<void*, size_t>, window> blocks {};
+		for(size_t i = 0; i < window; ++i) {
+			auto size = distribution[thread * 7 + i];
+			blocks[i] = {resource.allocate(size, alignment).data, size};
+		}
+		std::mt19937 rng {(unsigned)thread};
+		for(size_t i = 0; i < iterations; ++i) {
+			auto& [block, size] = blocks[rng() % window];
+			resource.deallocate(block, size, alignment);
+			size  = distribution[thread * 7 + i];
+			block = resource.allocate(size, alignment).data;
+			do_not_optimize(block);
+		}
+		for(auto [block, size] : blocks) resource.deallocate(block, size, alignment);
+	});
+}
+
+struct node_t {
+	node_t* next {nullptr};
+	size_t values[3] {};
+};
+
+template <typename Resource>
+measurement construct_destroy(Resource& resource) {
+	auto allocator = allocator_for(&resource);
+	return measure(iterations, [&] {
+		std::array<node_t*, window> nodes {};
+		for(size_t round = 0; round < iterations / window; ++round) {
+			for(size_t i = 0; i < window; ++i) nodes[i] = psl::construct<node_t>(allocator).data;
+			do_not_optimize(nodes);
+			for(size_t i = window; i > 0; --i) psl::destroy(allocator, *nodes[i - 1]);
+			reset(resource);
+		}
+	});
+}
+
+template <typename Resource>
+measurement construct_n(Resource& resource) {
+	constexpr size_t count = 256;
+	auto allocator		   = allocator_for(&resource);
+	return measure(iterations, [&] {
+		for(size_t round = 0; round < iterations / count; ++round) {
+			auto res = psl::construct_n<node_t>(allocator, count);
+			do_not_optimize(res.data);
+			std::destroy_n(res.data, count);
+			allocator.deallocate(res.data, sizeof(node_t) * count);
+			reset(resource);
+		}
+	});
+}
+
+template <typename Resource>
+measurement array_growth(Resource& resource) {
+	using allocator_t			 = decltype(allocator_for(&resource));
+	constexpr size_t elements	 = 1 << 14;
+	constexpr size_t repetitions = 16;
+	auto allocator				 = allocator_for(&resource);
+	return measure(elements * repetitions, [&] {
+		for(size_t round = 0; round < repetitions; ++round) {
+			{
+				psl::array<int, psl::dynamic_extent, psl::settings::array<allocator_t>> values {allocator};
+				for(int i = 0; i < (int)elements; ++i) values.emplace_back(i);
+				do_not_optimize(values[elements - 1]);
+			}
+			reset(resource);
+		}
+	});
+}
+
+/**
+ * \brief registers every workload for the resource created by `make`.
+ */
+template <typename Make>
+void register_resource(std::string const& name, bool synchronized, Make make) {
+	using resource_t = typename decltype(make())::element_type;
+	for(size_t index = 0; index < distributions().size(); ++index) {
+		std::string distribution = distributions()[index].name;
+		std::vector<size_t> threads {1};
+		if(synchronized)
+			threads.emplace_back(concurrent_threads);
+		for(size_t thread_count : threads) {
+			auto suffix = "/" + distribution + "/" + std::to_string(thread_count) + "_threads";
+			benchmark(name + "/lifo" + suffix) = [=] {
+				auto resource = make();
+				return lifo(*resource, distributions()[index], thread_count);
+			};
+			if constexpr(!is_arena<resource_t>) {
+				benchmark(name + "/random" + suffix) = [=] {
+					auto resource = make();
+					return random_replace(*resource, distributions()[index], thread_count);
+				};
+			}
+		}
+	}
+	benchmark(name + "/construct_destroy") = [=] {
+		auto resource = make();
+		return construct_destroy(*resource);
+	};
+	benchmark(name + "/construct_n") = [=] {
+		auto resource = make();
+		return construct_n(*resource);
+	};
+	benchmark(name + "/array_growth") = [=] {
+		auto resource = make();
+		return array_growth(*resource);
+	};
+}
+
+/**
+ * \brief creates a resource that depends on a caller owned region, which is freed along with it.
+ */
+template <typename Resource, typename... Args>
+std::shared_ptr<Resource> make_with_region(size_t size, Args&&... args) {
+	std::shared_ptr<std::byte[]> region {new std::byte[size]};
+	return std::shared_ptr<Resource> {new Resource {alignment, region.get(), size, std::forward<Args>(args)...},
+									  [region](Resource* resource) { delete resource; }};
+}
+
+auto registration = [] {
+	register_resource("new_resource", true, [] { return std::make_shared<psl::new_resource>(alignment); });
+	register_resource("malloc_resource", true, [] { return std::make_shared<psl::malloc_resource>(alignment); });
+	register_resource("pool_resource", false, [] { return std::make_shared<psl::pool_resource<>>(alignment); });
+	register_resource(
+	  "thread_cache_resource", true, [] { return std::make_shared<psl::thread_cache_resource<>>(alignment); });
+	register_resource(
+	  "thread_arena_resource", true, [] { return std::make_shared<psl::thread_arena_resource<>>(alignment); });
+	register_resource("concurrent_pool_resource", true, [] {
+		return std::make_shared<psl::concurrent_pool_resource<>>(alignment, 256, 1024);
+	});
+	register_resource(
+	  "huge_page_resource", true, [] { return std::make_shared<psl::huge_page_resource<>>(alignment); });
+	register_resource("buddy_resource", false, [] {
+		return std::make_shared<psl::buddy_resource<>>(alignment, capacity);
+	});
+	register_resource("tlsf_resource", false, [] { return make_with_region<psl::tlsf_resource<>>(capacity); });
+	register_resource(
+	  "monotonic_resource", false, [] { return std::make_shared<psl::monotonic_resource<>>(alignment); });
+	register_resource("stack_resource", false, [] {
+		return std::make_shared<psl::stack_resource<>>(alignment, size_t {64} << 20);
+	});
+	// the virtual memory resource only reclaims its most recent block, so it only backs the growing array.
+	benchmark("virtual_memory_resource/array_growth") = [] {
+		psl::virtual_memory_resource resource {alignment, size_t {1} << 30};
+		return array_growth(resource);
+	};
+	return 0;
+}();
+}	 // namespace
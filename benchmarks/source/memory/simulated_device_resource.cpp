@@ -0,0 +1,54 @@
+#include <benchmarks/benchmark.hpp>
+#include <cmath>
+#include <psl/memory/simulated_device_resource.hpp>
+#include <vector>
+
+using namespace benchmarks;
+using namespace std::chrono_literals;
+
+namespace {
+constexpr size_t chunks		= 64;
+constexpr size_t chunk_size = 1 << 16;	  // floats per chunk.
+
+/**
+ * \brief produces the next chunk of data to upload, which takes in the order of the transfer latency.
+ */
+void compute(std::vector<float>& chunk, size_t index) {
+	for(size_t i = 0; i < chunk.size(); ++i) chunk[i] = std::sqrt((float)(index * chunk.size() + i));
+	do_not_optimize(chunk.data());
+}
+
+/**
+ * \brief computes and uploads every chunk in turn, either waiting on every upload, or computing the next chunk while
+ * the previous one is in flight (double buffered).
+ */
+measurement upload(bool overlapped) {
+	psl::simulated_device_resource<> device {alignof(float), 20us, size_t {2} << 30};
+	auto block = device.allocate(chunks * chunk_size * sizeof(float), alignof(float));
+	std::vector<float> staging[2] {std::vector<float>(chunk_size), std::vector<float>(chunk_size)};
+	psl::completion_token<bool> in_flight[2] {};
+
+	auto result = measure(chunks, [&] {
+		for(size_t index = 0; index < chunks; ++index) {
+			auto slot = overlapped ? index % 2 : 0;
+			// the staging buffer can only be refilled once its previous upload completed.
+			if(in_flight[slot].valid())
+				in_flight[slot].wait();
+			compute(staging[slot], index);
+			auto* destination = (float*)block.data + index * chunk_size;
+			in_flight[slot]	  = device.write_async(destination, staging[slot].data(), chunk_size * sizeof(float));
+			if(!overlapped)
+				in_flight[slot].wait();
+		}
+		device.synchronize();
+	});
+	device.deallocate(block.data, chunks * chunk_size * sizeof(float), alignof(float));
+	return result;
+}
+
+auto registration = [] {
+	benchmark("simulated_device_resource/upload/serial") = [] { return upload(false); };
+	benchmark("simulated_device_resource/upload/overlapped") = [] { return upload(true); };
+	return 0;
+}();
+}	 // namespace
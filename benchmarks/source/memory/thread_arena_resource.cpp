@@ -0,0 +1,67 @@
+#include <atomic>
+#include <benchmarks/benchmark.hpp>
+#include <psl/memory/thread_arena_resource.hpp>
+#include <psl/memory/thread_cache_resource.hpp>
+#include <thread>
+#include <vector>
+
+using namespace benchmarks;
+
+namespace {
+constexpr size_t block_size = 64;
+constexpr size_t iterations = 1 << 18;
+constexpr size_t queue_size = 1024;
+
+/**
+ * \brief every producer allocates blocks that its consumer frees, through a single producer single consumer ring.
+ */
+template <typename Resource>
+measurement pipeline(Resource& resource, size_t pairs) {
+	return measure(iterations * pairs, [&] {
+		std::vector<std::thread> threads {};
+		std::vector<std::vector<std::atomic<void*>>> queues {};
+		for(size_t p = 0; p < pairs; ++p) queues.emplace_back(queue_size);
+		for(size_t p = 0; p < pairs; ++p) {
+			auto& queue = queues[p];
+			threads.emplace_back([&] {
+				for(size_t i = 0; i < iterations; ++i) {
+					auto* block = resource.allocate(block_size, 8).data;
+					do_not_optimize(block);
+					auto& slot = queue[i % queue_size];
+					while(slot.load(std::memory_order_acquire) != nullptr) std::this_thread::yield();
+					slot.store(block, std::memory_order_release);
+				}
+			});
+			threads.emplace_back([&] {
+				for(size_t i = 0; i < iterations; ++i) {
+					auto& slot = queue[i % queue_size];
+					void* block {nullptr};
+					while((block = slot.load(std::memory_order_acquire)) == nullptr) std::this_thread::yield();
+					slot.store(nullptr, std::memory_order_release);
+					resource.deallocate(block, block_size, 8);
+				}
+			});
+		}
+		for(auto& thread : threads) thread.join();
+	});
+}
+
+auto registration = [] {
+	for(size_t pairs : {1, 4}) {
+		auto suffix = "/pipeline/" + std::to_string(pairs) + "_pairs";
+		benchmark("new_resource" + suffix) = [pairs] {
+			psl::new_resource resource {8};
+			return pipeline(resource, pairs);
+		};
+		benchmark("thread_cache_resource" + suffix) = [pairs] {
+			psl::thread_cache_resource<> resource {8};
+			return pipeline(resource, pairs);
+		};
+		benchmark("thread_arena_resource" + suffix) = [pairs] {
+			psl::thread_arena_resource<> resource {8};
+			return pipeline(resource, pairs);
+		};
+	}
+	return 0;
+}();
+}	 // namespace
@@ -0,0 +1,68 @@
+#include <benchmarks/benchmark.hpp>
+#include <memory>
+#include <psl/memory/offset_resource.hpp>
+#include <psl/memory/tlsf_resource.hpp>
+#include <random>
+#include <vector>
+
+using namespace benchmarks;
+
+namespace {
+constexpr size_t iterations	 = 1 << 20;
+constexpr size_t live_blocks = 4096;
+constexpr size_t min_size	 = 16;
+constexpr size_t max_size	 = 4096;
+constexpr size_t region_size = size_t {64} << 20;
+
+/**
+ * \brief keeps a window of live blocks of random sizes, every operation frees a random block and allocates a new one
+ * in its place. The latency of every free + allocate pair is recorded.
+ */
+template <typename Resource>
+measurement mixed(Resource& resource) {
+	std::mt19937 rng {1234};
+	std::uniform_int_distribution<size_t> size_distribution {min_size, max_size};
+	std::vector<std::pair<void*, size_t>> window(live_blocks);
+	for(auto& [block, size] : window) {
+		size  = size_distribution(rng);
+		block = resource.allocate(size, 8).data;
+	}
+
+	std::vector<std::pair<size_t, size_t>> operations(iterations);
+	for(auto& [slot, size] : operations) {
+		slot = rng() % live_blocks;
+		size = size_distribution(rng);
+	}
+
+	auto result = measure_latency(iterations, [&](size_t index) {
+		auto [slot, size] = operations[index];
+		auto& entry		  = window[slot];
+		resource.deallocate(entry.first, entry.second, 8);
+		entry = {resource.allocate(size, 8).data, size};
+		do_not_optimize(entry.first);
+	});
+	for(auto& [block, size] : window) resource.deallocate(block, size, 8);
+	return result;
+}
+
+auto registration = [] {
+	benchmark("new_resource/mixed/latency") = [] {
+		psl::new_resource resource {8};
+		return mixed(resource);
+	};
+	benchmark("tlsf_resource/mixed/latency") = [] {
+		auto region = std::make_unique<std::byte[]>(region_size);
+		psl::tlsf_resource<> resource {8, region.get(), region_size};
+		return mixed(resource);
+	};
+	benchmark("tlsf_resource<false>/mixed/latency") = [] {
+		psl::tlsf_resource<false> resource {8, (void*)std::uintptr_t {0x1000}, region_size};
+		return mixed(resource);
+	};
+	benchmark("offset_resource/mixed/latency") = [] {
+		psl::offset_resource resource {8, (void*)std::uintptr_t {0x1000}, region_size, 16};
+		return mixed(resource);
+	};
+	return 0;
+}();
+}	 // namespace
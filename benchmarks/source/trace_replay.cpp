@@ -0,0 +1,242 @@
+#include <benchmarks/benchmark.hpp>
+#include <cstdio>
+#include <memory>
+#include <psl/memory/buddy_resource.hpp>
+#include <psl/memory/huge_page_resource.hpp>
+#include <psl/memory/monotonic_resource.hpp>
+#include <psl/memory/pool_resource.hpp>
+#include <psl/memory/thread_cache_resource.hpp>
+#include <psl/memory/tlsf_resource.hpp>
+#include <psl/memory/trace_resource.hpp>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+/**
+ * \brief trace event, with its address replaced by an index into the live block table.
+ */
+struct operation_t {
+	size_t slot;
+	size_t size;
+	size_t alignment;
+	bool allocate;
+};
+
+/**
+ * \brief block that is live in a slot during the replay.
+ */
+struct live_block_t {
+	void* data {nullptr};
+	size_t size {0};
+	size_t alignment {0};
+};
+
+struct trace_t {
+	std::vector<operation_t> operations {};
+	size_t slots {0};
+	size_t peak_live_bytes {0};
+};
+
+struct result_t {
+	benchmarks::measurement measurement {};
+	size_t peak_rss {0};
+	size_t peak_live_bytes {0};
+	size_t failures {0};
+};
+
+size_t current_rss() {
+#if defined(__linux__)
+	std::unique_ptr<std::FILE, int (*)(std::FILE*)> file {std::fopen("/proc/self/statm", "r"), &std::fclose};
+	unsigned long long pages {0}, resident {0};
+	if(file && std::fscanf(file.get(), "%llu %llu", &pages, &resident) == 2)
+		return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+#endif
+	return 0;
+}
+
+/**
+ * \brief Returns the memory that was freed by earlier replays (and by loading the trace) to the OS, so that the next
+ * replay starts from a clean baseline.
+ */
+size_t baseline_rss() {
+#if defined(__GLIBC__)
+	malloc_trim(0);
+#endif
+	return current_rss();
+}
+
+trace_t prepare(std::vector<psl::trace_event_t> const& events) {
+	trace_t trace {};
+	trace.operations.reserve(events.size());
+	std::unordered_map<std::uint64_t, size_t> live {};
+	std::vector<size_t> free_slots {};
+	size_t live_bytes {0};
+	for(auto const& event : events) {
+		if(event.operation == psl::trace_operation::allocate) {
+			size_t slot {trace.slots};
+			if(!free_slots.empty()) {
+				slot = free_slots.back();
+				free_slots.pop_back();
+			} else
+				++trace.slots;
+			live[event.address] = slot;
+			trace.operations.emplace_back(slot, (size_t)event.size, (size_t)event.alignment, true);
+			live_bytes += event.size;
+			trace.peak_live_bytes = std::max(trace.peak_live_bytes, live_bytes);
+		} else if(event.operation == psl::trace_operation::deallocate) {
+			// deallocations of blocks that were never seen being allocated are dropped.
+			auto it = live.find(event.address);
+			if(it == live.end())
+				continue;
+			trace.operations.emplace_back(it->second, (size_t)event.size, (size_t)event.alignment, false);
+			free_slots.emplace_back(it->second);
+			live.erase(it);
+			live_bytes -= event.size;
+		}
+	}
+	return trace;
+}
+
+template <typename Resource>
+result_t replay(Resource& resource, trace_t const& trace, size_t baseline_rss) {
+	constexpr size_t sample_interval = 4096;
+	constexpr size_t page_size		 = 4096;
+	result_t result {};
+	std::vector<live_block_t> blocks(trace.slots);
+	size_t live_bytes {0};
+	result.measurement = benchmarks::measure(trace.operations.size(), [&] {
+		for(size_t index = 0; index < trace.operations.size(); ++index) {
+			auto const& operation = trace.operations[index];
+			if(operation.allocate) {
+				auto res = resource.allocate(operation.size, operation.alignment);
+				if(!res) {
+					++result.failures;
+					continue;
+				}
+				// touch every page, like the recorded application would, so that the block shows up in the RSS.
+				for(size_t offset = 0; offset < operation.size; offset += page_size)
+					((volatile std::byte*)res.data)[offset] = std::byte {0};
+				blocks[operation.slot] = {res.data, operation.size, operation.alignment};
+				live_bytes += operation.size;
+			} else if(auto block = std::exchange(blocks[operation.slot], {}); block.data) {
+				resource.deallocate(block.data, operation.size, operation.alignment);
+				live_bytes -= operation.size;
+			}
+
+			if(live_bytes > result.peak_live_bytes)
+				result.peak_live_bytes = live_bytes;
+			if(index % sample_interval == 0)
+				result.peak_rss = std::max(result.peak_rss, current_rss());
+		}
+		result.peak_rss = std::max(result.peak_rss, current_rss());
+	});
+	result.peak_rss = (result.peak_rss > baseline_rss) ? result.peak_rss - baseline_rss : 0;
+
+	// slots are reused, so the blocks that are still live are freed with the size they were allocated with.
+	for(auto const& block : blocks)
+		if(block.data)
+			resource.deallocate(block.data, block.size, block.alignment);
+	return result;
+}
+
+void report(char const* name, result_t const& result) {
+	auto fragmentation = (result.peak_rss == 0)
+						   ? 0.0
+						   : std::max(0.0, 1.0 - (double)result.peak_live_bytes / (double)result.peak_rss);
+	std::printf("%-24s %12zu ops %10.3f ms %14.0f ops/s %10.2f MiB rss %7.2f%% fragmentation %8zu failures\n",
+				name,
+				result.measurement.operations,
+				(double)result.measurement.duration.count() / 1e6,
+				result.measurement.operations_per_second(),
+				(double)result.peak_rss / (1024.0 * 1024.0),
+				fragmentation * 100.0,
+				result.failures);
+}
+
+struct candidate_t {
+	char const* name;
+	result_t (*run)(trace_t const& trace, size_t baseline_rss);
+};
+
+/**
+ * \brief The resources to replay against, the ones with a fixed capacity are sized to twice the peak of the trace.
+ */
+constexpr std::array<candidate_t, 7> candidates {{
+  {"new_resource",
+   [](trace_t const& trace, size_t rss) {
+	   psl::new_resource resource {1};
+	   return replay(resource, trace, rss);
+   }},
+  {"pool_resource",
+   [](trace_t const& trace, size_t rss) {
+	   psl::pool_resource<> resource {1};
+	   return replay(resource, trace, rss);
+   }},
+  {"thread_cache_resource",
+   [](trace_t const& trace, size_t rss) {
+	   psl::thread_cache_resource<> resource {1};
+	   return replay(resource, trace, rss);
+   }},
+  {"huge_page_resource",
+   [](trace_t const& trace, size_t rss) {
+	   psl::huge_page_resource<> resource {1};
+	   return replay(resource, trace, rss);
+   }},
+  {"monotonic_resource",
+   [](trace_t const& trace, size_t rss) {
+	   psl::monotonic_resource<> resource {1, 1 << 20};
+	   return replay(resource, trace, rss);
+   }},
+  {"buddy_resource",
+   [](trace_t const& trace, size_t rss) {
+	   psl::buddy_resource<> resource {1, std::bit_ceil(std::max<size_t>(trace.peak_live_bytes * 2, 1 << 20))};
+	   return replay(resource, trace, rss);
+   }},
+  {"tlsf_resource",
+   [](trace_t const& trace, size_t rss) {
+	   auto size = std::max<size_t>(trace.peak_live_bytes * 2, 1 << 20);
+	   auto region = std::make_unique_for_overwrite<std::byte[]>(size);
+	   psl::tlsf_resource<> resource {1, region.get(), size};
+	   return replay(resource, trace, rss);
+   }},
+}};
+}	 // namespace
+
+/**
+ * \brief Replays a trace recorded by `psl::trace_resource` against a set of memory resources.
+ * \details usage: `psl_trace_replay <trace> [resource...]`, when no resources are given all of them are replayed.
+ * For every resource the throughput, the peak resident set size (RSS) and the fragmentation are reported, where the
+ * fragmentation is the part of the RSS growth that was not used by live allocations at the peak.
+ * The trace is replayed in timestamp order on a single thread.
+ * \note RSS is measured for the whole process, and memory that a resource gives back is not always returned to the
+ * OS. Replay one resource per invocation for the most accurate RSS figures.
+ */
+int main(int argc, char* argv[]) {
+	if(argc < 2) {
+		std::printf("usage: %s <trace> [resource...]\nresources:", argv[0]);
+		for(auto const& candidate : candidates) std::printf(" %s", candidate.name);
+		std::printf("\n");
+		return 1;
+	}
+
+	auto trace = prepare(psl::read_trace(argv[1]));
+	std::printf("%zu operations, %zu blocks, %.2f MiB peak live\n",
+				trace.operations.size(),
+				trace.slots,
+				(double)trace.peak_live_bytes / (1024.0 * 1024.0));
+
+	for(auto const& candidate : candidates) {
+		if(argc > 2 && std::none_of(argv + 2, argv + argc, [&](char const* name) {
+			   return std::string_view {name} == candidate.name;
+		   }))
+			continue;
+		report(candidate.name, candidate.run(trace, baseline_rss()));
+	}
+	return 0;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <psl/algorithms.hpp>
+#include <psl/allocator_traits.hpp>
+
+namespace psl::traits {
+/**
+ * \brief Keeps allocation statistics on the memory resource, which can be read at any time through `snapshot()`.
+ * \details The statistics are a set of relaxed atomic counters that are updated by the `basic_allocation` interface of
+ * the resource (and by the `bound_allocator`), so they are safe to read from another thread (such as a metrics
+ * thread) while the resource is in use, and never take a lock. Resources that don't have this trait pay nothing for
+ * it.
+ * Sizes are tracked as follows:
+ * - `live_bytes` grows by the requested size and shrinks by the size given on deallocation, both rounded up to the
+ *   alignment of the resource. Callers can deallocate with either the requested size or `alloc_results::size()`, it
+ *   stays exact as long as the resource doesn't report more slack than that rounding.
+ * - the histogram is indexed by the requested size, bucket `i` counts the requests in the range (2^(i-1), 2^i], and
+ *   the last bucket also counts everything larger.
+ * \note `reallocate` is not tracked.
+ */
+struct allocation_statistics_t {
+	inline constexpr static size_t histogram_size {32};
+
+	/**
+	 * \brief Copy of the statistics at one point in time.
+	 * \note The counters are read one by one, so a snapshot taken while the resource is in use can be slightly
+	 * inconsistent (for example `peak_bytes` being smaller than `live_bytes`).
+	 */
+	struct snapshot_t {
+		size_t live_bytes {0};
+		size_t peak_bytes {0};
+		size_t allocations {0};
+		size_t deallocations {0};
+		size_t failed_allocations {0};
+		std::array<size_t, histogram_size> histogram {};
+	};
+
+	/**
+	 * \returns the histogram bucket that counts allocations of the given size.
+	 */
+	static constexpr size_t histogram_index(size_t size) noexcept {
+		return std::min<size_t>(std::bit_width((size > 0) ? size - 1 : 0), histogram_size - 1);
+	}
+};
+
+template <typename Y>
+struct memory_resource_trait<allocation_statistics_t, Y> {
+  public:
+	memory_resource_trait() noexcept = default;
+
+	memory_resource_trait(memory_resource_trait const&)			   = delete;
+	memory_resource_trait(memory_resource_trait&&)				   = delete;
+	memory_resource_trait& operator=(memory_resource_trait const&) = delete;
+	memory_resource_trait& operator=(memory_resource_trait&&)	   = delete;
+
+	/**
+	 * \returns the current statistics of the resource.
+	 */
+	allocation_statistics_t::snapshot_t snapshot() const noexcept {
+		allocation_statistics_t::snapshot_t result {};
+		result.live_bytes		  = m_LiveBytes.load(std::memory_order_relaxed);
+		result.peak_bytes		  = m_PeakBytes.load(std::memory_order_relaxed);
+		result.allocations		  = m_Allocations.load(std::memory_order_relaxed);
+		result.deallocations	  = m_Deallocations.load(std::memory_order_relaxed);
+		result.failed_allocations = m_FailedAllocations.load(std::memory_order_relaxed);
+		for(size_t i = 0; i < allocation_statistics_t::histogram_size; ++i)
+			result.histogram[i] = m_Histogram[i].load(std::memory_order_relaxed);
+		return result;
+	}
+
+	/**
+	 * \brief Records the outcome of an allocation of `size` bytes.
+	 */
+	void record_allocation(size_t size, alloc_results<void> const& result) noexcept {
+		if(!result) {
+			m_FailedAllocations.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		record(size, 1);
+	}
+
+	/**
+	 * \brief Records the outcome of a batch of `count` allocations of `size` bytes, of which `allocated` succeeded.
+	 */
+	void record_allocation_batch(size_t size, size_t count, size_t allocated) noexcept {
+		if(allocated < count)
+			m_FailedAllocations.fetch_add(1, std::memory_order_relaxed);
+		if(allocated > 0)
+			record(size, allocated);
+	}
+
+	/**
+	 * \brief Records `count` deallocations of `size` bytes.
+	 */
+	void record_deallocation(size_t size, size_t count = 1) noexcept {
+		m_Deallocations.fetch_add(count, std::memory_order_relaxed);
+		m_LiveBytes.fetch_sub(charged(size) * count, std::memory_order_relaxed);
+	}
+
+  private:
+	size_t charged(size_t size) const noexcept {
+		return psl::align_to<size_t>(size, ((Y const*)this)->alignment());
+	}
+
+	void record(size_t size, size_t count) noexcept {
+		m_Allocations.fetch_add(count, std::memory_order_relaxed);
+		m_Histogram[allocation_statistics_t::histogram_index(size)].fetch_add(count, std::memory_order_relaxed);
+
+		auto bytes = charged(size) * count;
+		auto live  = m_LiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		auto peak = m_PeakBytes.load(std::memory_order_relaxed);
+		while(live > peak && !m_PeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+	}
+
+	std::atomic<size_t> m_LiveBytes {0};
+	std::atomic<size_t> m_PeakBytes {0};
+	std::atomic<size_t> m_Allocations {0};
+	std::atomic<size_t> m_Deallocations {0};
+	std::atomic<size_t> m_FailedAllocations {0};
+	std::array<std::atomic<size_t>, allocation_statistics_t::histogram_size> m_Histogram {};
+};
+}	 // namespace psl::traits
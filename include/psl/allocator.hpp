@@ -1,6 +1,13 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <numeric>
+#include <psl/algorithms.hpp>
 #include <psl/allocator_traits.hpp>
 #include <psl/config.hpp>
+#include <psl/details/heap.hpp>
+#include <psl/exceptions.hpp>
 #include <psl/fwd/allocator.hpp>
 #include <psl/types.hpp>
 #include <type_traits>
@@ -55,6 +62,13 @@ class traited_memory_resource : public traits::memory_resource_trait<Traits, tra
 	}
 };
 
+/**
+ * \brief Satisfied by memory resources that can be used as the upstream (backing) resource of another resource.
+ */
+template <typename T>
+concept IsMemoryResource =
+  std::is_base_of_v<abstract_memory_resource, T> && traits::HasTrait<T, traits::basic_allocation>;
+
 /**
  * \brief Traited allocator class, as a replacement for the `std::pmr::allocator`
  * @details The allocator class internally derives its behaviour and functionality based on the traits.
@@ -84,26 +98,42 @@ class allocator final : public traits::allocator_trait<Traits, allocator<Traits.
 
 	traited_memory_resource_t* resource() { return m_MemoryResource; }
 
+	/**
+	 * \brief Allocators are equal when they source from the same memory resource, so that memory allocated through one
+	 * can be deallocated through the other.
+	 */
+	friend bool operator==(allocator const& lhs, allocator const& rhs) noexcept {
+		return lhs.m_MemoryResource == rhs.m_MemoryResource;
+	}
+
+	template <typename T>
+	static consteval bool has_trait() {
+		return traited_memory_resource_t::template has_trait<T>();
+	}
+
   private:
 	traited_memory_resource_t* m_MemoryResource {nullptr};
 };
 
-template <typename T, typename... Traits, typename... Args>
-[[nodiscard]] alloc_results<T> construct(allocator<Traits...>& allocator, Args&&... args) {
+template <typename T, typename Allocator, typename... Args>
+	requires traits::HasTrait<Allocator, traits::basic_allocation>
+[[nodiscard]] alloc_results<T> construct(Allocator& allocator, Args&&... args) {
 	auto res = allocator.template allocate<T>();
 	new(res.data) T {std::forward<Args>(args)...};
 	return res;
 }
 
-template <typename T, typename... Traits, typename... Args>
-[[nodiscard]] alloc_results<T> construct_n(allocator<Traits...>& allocator, size_t count, Args&&... args) {
+template <typename T, typename Allocator, typename... Args>
+	requires traits::HasTrait<Allocator, traits::basic_allocation>
+[[nodiscard]] alloc_results<T> construct_n(Allocator& allocator, size_t count, Args&&... args) {
 	auto res = allocator.template allocate_n<T>(count);
 	for(auto ptr = res.data, end = ptr + count; ptr != end; ++ptr) new(ptr) T {std::forward<Args>(args)...};
 	return res;
 }
 
-template <typename T, typename... Traits>
-bool destroy(allocator<Traits...>& allocator, T& object) {
+template <typename T, typename Allocator>
+	requires traits::HasTrait<Allocator, traits::basic_allocation>
+bool destroy(Allocator& allocator, T& object) {
 	if constexpr(std::is_pointer_v<T>) {
 		return destroy<T>(allocator, *object);
 	} else {
@@ -112,17 +142,248 @@ bool destroy(allocator<Traits...>& allocator, T& object) {
 	}
 }
 
+namespace _priv {
+/**
+ * \brief Grants `bound_allocator` non-virtual access to the implementation of a memory resource.
+ * \details Resources that befriend this type have their `do_allocate`/`do_deallocate` called directly (which allows
+ * them to be inlined), other resources are called through their virtual interface.
+ */
+struct resource_access {
+	template <typename Resource>
+	static alloc_results<void> allocate(Resource& resource, size_t size, size_t alignment) {
+		if constexpr(requires { resource.Resource::do_allocate(size, alignment); }) {
+			auto res = resource.Resource::do_allocate(size, alignment);
+			if constexpr(traits::HasTrait<Resource, traits::allocation_statistics_t>)
+				resource.record_allocation(size, res);
+			return res;
+		} else
+			return resource.allocate(size, alignment);
+	}
+
+	template <typename Resource>
+	static bool deallocate(Resource& resource, void* ptr, size_t size, size_t alignment) {
+		if constexpr(requires { resource.Resource::do_deallocate(ptr, size, alignment); }) {
+			auto success = resource.Resource::do_deallocate(ptr, size, alignment);
+			if constexpr(traits::HasTrait<Resource, traits::allocation_statistics_t>)
+				if(success && ptr)
+					resource.record_deallocation(size);
+			return success;
+		} else
+			return resource.deallocate(ptr, size, alignment);
+	}
+
+	template <typename Resource>
+	static size_t allocate_batch(Resource& resource, size_t size, size_t alignment, size_t count, void** items) {
+		if constexpr(requires { resource.Resource::do_allocate_batch(size, alignment, count, items); }) {
+			auto allocated = resource.Resource::do_allocate_batch(size, alignment, count, items);
+			if constexpr(traits::HasTrait<Resource, traits::allocation_statistics_t>)
+				resource.record_allocation_batch(size, count, allocated);
+			return allocated;
+		} else
+			return resource.allocate_batch(size, alignment, count, items);
+	}
+
+	template <typename Resource>
+	static bool deallocate_batch(Resource& resource, void* const* items, size_t count, size_t size, size_t alignment) {
+		if constexpr(requires { resource.Resource::do_deallocate_batch(items, count, size, alignment); }) {
+			auto success = resource.Resource::do_deallocate_batch(items, count, size, alignment);
+			if constexpr(traits::HasTrait<Resource, traits::allocation_statistics_t>)
+				if(success)
+					resource.record_deallocation(size, count);
+			return success;
+		} else
+			return resource.deallocate_batch(items, count, size, alignment);
+	}
+};
+}	 // namespace _priv
+
+/**
+ * \brief Allocator that is bound to a concrete memory resource type, instead of to the `traited_memory_resource`.
+ * \details As the resource type is known, calls into it are made without virtual dispatch, and can be inlined
+ * entirely (see `_priv::resource_access`). It exposes the same interface as the `allocator` for the traits of the
+ * resource, and so can be used by containers such as `psl::array` in its place.
+ *
+ * \tparam Resource concrete memory resource type.
+ * \tparam Alignment alignment of the resource when it is known at compile time, or 0 when it is not. This lets the
+ * resource's alignment calculations be resolved at compile time. The resource's alignment is verified on
+ * construction.
+ */
+template <typename Resource, size_t Alignment = 0>
+	requires(std::is_base_of_v<abstract_memory_resource, Resource> &&
+			 traits::HasTrait<Resource, traits::basic_allocation>)
+class bound_allocator final {
+  public:
+	using resource_type = Resource;
+	inline constexpr static size_t static_alignment {Alignment};
+
+	bound_allocator() = default;
+	bound_allocator(Resource* memoryResource) noexcept(!config::exceptions) : m_MemoryResource(memoryResource) {
+		if constexpr(Alignment != 0) {
+			PSL_EXCEPT_IF(memoryResource && memoryResource->alignment() != Alignment,
+						  std::runtime_error,
+						  "the resource's alignment does not match the bound_allocator's alignment");
+		}
+	}
+	~bound_allocator() = default;
+
+	bound_allocator(bound_allocator const& other) noexcept			  = default;
+	bound_allocator(bound_allocator&& other) noexcept				  = default;
+	bound_allocator& operator=(bound_allocator const& other) noexcept = default;
+	bound_allocator& operator=(bound_allocator&& other) noexcept	  = default;
+
+	abstract_memory_resource* abstract_resource() { return m_MemoryResource; }
+
+	Resource* resource() { return m_MemoryResource; }
+
+	/**
+	 * \brief Allocators are equal when they source from the same memory resource, so that memory allocated through one
+	 * can be deallocated through the other.
+	 */
+	friend bool operator==(bound_allocator const& lhs, bound_allocator const& rhs) noexcept {
+		return lhs.m_MemoryResource == rhs.m_MemoryResource;
+	}
+
+	template <typename T>
+	static consteval bool has_trait() {
+		return Resource::template has_trait<T>();
+	}
+
+	template <typename T>
+	alloc_results<T> allocate(size_t bytes = sizeof(T)) {
+		return static_cast<alloc_results<T>>(_priv::resource_access::allocate(bound(), bytes, alignof(T)));
+	}
+
+	template <typename T>
+	alloc_results<T> allocate_n(size_t count, size_t bytes = sizeof(T)) {
+		return static_cast<alloc_results<T>>(_priv::resource_access::allocate(bound(), bytes * count, alignof(T)));
+	}
+
+	template <typename T>
+	bool deallocate(T* object, size_t bytes = sizeof(T)) {
+		return _priv::resource_access::deallocate(bound(), object, bytes, alignof(T));
+	}
+
+	template <typename T>
+	size_t allocate_batch(T** objects, size_t count, size_t bytes = sizeof(T)) {
+		return _priv::resource_access::allocate_batch(bound(), bytes, alignof(T), count, (void**)objects);
+	}
+
+	template <typename T>
+	bool deallocate_batch(T* const* objects, size_t count, size_t bytes = sizeof(T)) {
+		return _priv::resource_access::deallocate_batch(bound(), (void* const*)objects, count, bytes, alignof(T));
+	}
+
+	template <typename T>
+	alloc_results<T> reallocate(T* object, size_t count, size_t bytes = sizeof(T))
+		requires traits::IsReallocateAble<Resource>
+	{
+		return static_cast<alloc_results<T>>(bound().Resource::reallocate(object, bytes, count, alignof(T)));
+	}
+
+  private:
+	Resource& bound() noexcept {
+		if constexpr(Alignment != 0) {
+			if(m_MemoryResource->alignment() != Alignment)
+				std::unreachable();
+		}
+		return *m_MemoryResource;
+	}
+
+	Resource* m_MemoryResource {nullptr};
+};
+
 class new_resource
 	: public psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation> {
 	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
 
   public:
 	new_resource(size_t alignment) : base_type(alignment) {}
 
   private:
-	alloc_results<void> do_allocate(size_t size, size_t alignment) override;
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align		   = std::lcm(alignment, this->alignment());
+		auto stride		   = psl::align_to<size_t>(size, align);
+		auto aligned_bytes = psl::align_to<size_t>(size, this->alignment());
+
+		std::byte* res = (std::byte*)operator new(aligned_bytes, std::align_val_t {align});
+
+		PSL_EXCEPT_IF(!res, std::runtime_error, "no allocation happened");
+
+		alloc_results<void> result {};
+		result.data	  = res;
+		result.head	  = res;
+		result.tail	  = res + aligned_bytes;
+		result.stride = stride;
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, [[maybe_unused]] size_t size, size_t alignment) override {
+		operator delete(ptr, std::align_val_t {std::lcm(alignment, this->alignment())});
+		return true;
+	}
+};
+
+/**
+ * \brief Allocates from the C heap, and reports the full usable size of every block.
+ * \details The heap rounds requests up to its own size classes, the `alloc_results::tail` of every allocation covers
+ * that slack (where the platform can query it), so containers such as `psl::array` fill it before they grow.
+ */
+class malloc_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+										  psl::traits::basic_allocation,
+										  psl::traits::queryable_size_t> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::queryable_size_t>;
+	friend struct _priv::resource_access;
+
+  public:
+	malloc_resource(size_t alignment) : base_type(alignment) {}
+
+	malloc_resource(malloc_resource const&)			   = delete;
+	malloc_resource(malloc_resource&&)				   = delete;
+	malloc_resource& operator=(malloc_resource const&) = delete;
+	malloc_resource& operator=(malloc_resource&&)	   = delete;
+
+	/**
+	 * \returns the usable size in bytes of the blocks that are currently allocated.
+	 * \note The heap has no fixed capacity, so unlike the resources that own their memory up front this is not the
+	 * capacity of the resource, but the amount of bytes it currently hands out (including the heap's slack).
+	 */
+	size_t size() const noexcept override { return m_Size.load(std::memory_order_relaxed); }
+
+  private:
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		auto bytes = psl::align_to<size_t>(std::max<size_t>(size, 1), this->alignment());
+
+		std::byte* res = (std::byte*)_priv::heap::allocate(bytes, align);
+		PSL_EXCEPT_IF(!res, std::runtime_error, "no allocation happened");
+
+		// the slack past the last multiple of the alignment can not be reported, as the tail has to stay aligned.
+		auto usable = psl::ralign_to(_priv::heap::usable_size(res, bytes, align), this->alignment());
+		m_Size.fetch_add(usable, std::memory_order_relaxed);
+
+		alloc_results<void> result {};
+		result.data	  = res;
+		result.head	  = res;
+		result.tail	  = res + usable;
+		result.stride = psl::align_to<size_t>(size, align);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		auto align = std::lcm(alignment, this->alignment());
+		m_Size.fetch_sub(psl::ralign_to(_priv::heap::usable_size(ptr, size, align), this->alignment()),
+						 std::memory_order_relaxed);
+		_priv::heap::deallocate(ptr, align);
+		return true;
+	}
 
-	bool do_deallocate(void* ptr, size_t size, size_t alignment) override;
+	std::atomic<size_t> m_Size {0};
 };
 
 inline static psl::config::default_memory_resource_t default_memory_resource {alignof(char)};
@@ -35,6 +35,9 @@ struct physically_allocated_t : std::conditional_t<Value, std::true_type, std::f
 template <bool Value>
 struct shareable_t : std::conditional_t<Value, std::true_type, std::false_type> {};
 
+/**
+ * \brief The resource can report the size (in bytes) of the memory it manages.
+ */
 struct queryable_size_t {
 	virtual size_t size() const noexcept = 0;
 };
@@ -50,6 +53,31 @@ struct reallocate_able_t {
 
 struct host_reachable_t {};
 
+/**
+ * \brief Asynchronous allocation and access, for resources whose memory the host cannot (directly) reach.
+ * \details Every operation is queued, and returns a `psl::completion_token` (see `<psl/completion_token.hpp>`) that
+ * completes once the operation did. Operations on the same resource complete in the order they were queued, so a
+ * write can be queued right after the allocation it targets, and a deallocation after the transfers that use the block.
+ * Resources with this trait describe their access with `host_readability_t<syncronization::async>` and
+ * `host_writability_t<syncronization::async>`.
+ */
+struct async_access_t {
+	virtual completion_token<alloc_results<void>> allocate_async(size_t size, size_t alignment) = 0;
+	virtual completion_token<bool> deallocate_async(void* location, size_t size, size_t alignment) = 0;
+
+	/**
+	 * \brief Copies `size` bytes of host memory at `source` into the resource's memory at `destination`.
+	 * \note `source` has to stay valid until the operation completed.
+	 */
+	virtual completion_token<bool> write_async(void* destination, void const* source, size_t size) = 0;
+
+	/**
+	 * \brief Reads `size` bytes of the resource's memory at `source` back into host memory at `destination`.
+	 * \note `destination` has to stay valid until the operation completed.
+	 */
+	virtual completion_token<bool> read_async(void* destination, void const* source, size_t size) = 0;
+};
+
 enum class syncronization {
 	always_synced = 0, /* no effort needs to be done to access the data. */
 	flush		  = 1, /* requires a flush (or flush-like) interaction before the data can be accessed. */
@@ -99,6 +127,9 @@ concept IsSizeQueryable = HasTrait<T, queryable_size_t>;
 template <typename T>
 concept IsReallocateAble = HasTrait<T, reallocate_able_t>;
 
+template <typename T>
+concept IsAsyncAccessible = HasTrait<T, async_access_t>;
+
 template <typename Y>
 struct allocator_trait<basic_allocation, Y> {
   public:
@@ -110,6 +141,16 @@ struct allocator_trait<basic_allocation, Y> {
 
 	template <typename T>
 	bool deallocate(T* object, size_t bytes = sizeof(T));
+
+	/**
+	 * \brief Allocates `count` independently freeable blocks, see `memory_resource_trait<basic_allocation,
+	 * Y>::allocate_batch`.
+	 */
+	template <typename T>
+	size_t allocate_batch(T** objects, size_t count, size_t bytes = sizeof(T));
+
+	template <typename T>
+	bool deallocate_batch(T* const* objects, size_t count, size_t bytes = sizeof(T));
 };
 
 template <typename Y>
@@ -133,15 +174,136 @@ struct memory_resource_trait<basic_allocation, Y> {
 	 * \brief Deallocates the given item, this is the '.data' member from alloc_results<T>
 	 *
 	 * \param[in] item
-	 * \param[in] size Original size of the allocation
+	 * \param[in] size Original size of the allocation, this can be any value between the requested size and the
+	 * size reported by the `alloc_results` (i.e. `alloc_results::size()`).
 	 * \param[in] alignment Original alignment of the allocation
 	 * \returns true when the deallocation succeeds
 	 */
-	bool deallocate(void* item, size_t size, size_t alignment) { return do_deallocate(item, size, alignment); }
+	bool deallocate(void* item, size_t size, size_t alignment) {
+		auto success = do_deallocate(item, size, alignment);
+		if constexpr(HasTrait<Y, allocation_statistics_t>)
+			if(success && item)
+				((Y*)this)->record_deallocation(size);
+		return success;
+	}
+
+	/**
+	 * \brief Allocates `count` blocks of `size` bytes in one call, every block can be deallocated on its own.
+	 * \details Resources can override `do_allocate_batch` to service the whole batch at once (for example from a
+	 * single slab refill), by default every block is allocated individually.
+	 *
+	 * \param[in] size Size of every block
+	 * \param[in] alignment Alignment of every block
+	 * \param[in] count Amount of blocks to allocate
+	 * \param[out] items Receives the start of every block, has to fit `count` entries
+	 * \returns the amount of blocks that were allocated, this is less than `count` when the resource ran out.
+	 */
+	size_t allocate_batch(size_t size, size_t alignment, size_t count, void** items) {
+		PSL_CONTRACT_EXCEPT_IF(alignment == 0, "alignment value of 0 is not allowed, 1 is the minimum");
+		auto allocated = do_allocate_batch(size, alignment, count, items);
+		if constexpr(HasTrait<Y, allocation_statistics_t>)
+			((Y*)this)->record_allocation_batch(size, count, allocated);
+		return allocated;
+	}
+
+	/**
+	 * \brief Deallocates `count` blocks that were allocated with the given size and alignment.
+	 * \details The blocks don't have to originate from the same `allocate_batch` call.
+	 * \returns true when all deallocations succeed
+	 */
+	bool deallocate_batch(void* const* items, size_t count, size_t size, size_t alignment) {
+		auto success = do_deallocate_batch(items, count, size, alignment);
+		if constexpr(HasTrait<Y, allocation_statistics_t>)
+			if(success)
+				((Y*)this)->record_deallocation(size, count);
+		return success;
+	}
 
   protected:
 	virtual alloc_results<void> do_allocate(size_t size, size_t alignment) = 0;
 	virtual bool do_deallocate(void* ptr, size_t size, size_t alignment)   = 0;
+
+	virtual size_t do_allocate_batch(size_t size, size_t alignment, size_t count, void** items) {
+		for(size_t i = 0; i < count; ++i) {
+			auto res = do_allocate(size, alignment);
+			if(!res)
+				return i;
+			items[i] = res.data;
+		}
+		return count;
+	}
+
+	virtual bool do_deallocate_batch(void* const* items, size_t count, size_t size, size_t alignment) {
+		bool success {true};
+		for(size_t i = 0; i < count; ++i) success &= do_deallocate(items[i], size, alignment);
+		return success;
+	}
+};
+
+/**
+ * \brief Exposes the `queryable_size_t` interface on the memory resource.
+ */
+template <typename Y>
+struct memory_resource_trait<queryable_size_t, Y> : public queryable_size_t {};
+
+/**
+ * \brief Exposes the `reallocate_able_t` interface on the memory resource.
+ * \details `reallocate` tries to resize the block at `location` to fit `count` items of `size` bytes in place. When
+ * that is not possible, the resource may instead return a new allocation, in which case the original block is left
+ * untouched and remains owned by the caller (who is expected to move the contents and deallocate it). An invalid
+ * `alloc_results` is returned when neither is possible.
+ */
+template <typename Y>
+struct memory_resource_trait<reallocate_able_t, Y> : public reallocate_able_t {};
+
+template <typename Y>
+struct allocator_trait<reallocate_able_t, Y> {
+  public:
+	/**
+	 * \brief Attempts to resize the allocation of `object` to `count` elements, see
+	 * `memory_resource_trait<reallocate_able_t, Y>` for the semantics.
+	 */
+	template <typename T>
+	alloc_results<T> reallocate(T* object, size_t count, size_t bytes = sizeof(T));
+};
+
+/**
+ * \brief Exposes the `async_access_t` interface on the memory resource.
+ */
+template <typename Y>
+struct memory_resource_trait<async_access_t, Y> : public async_access_t {};
+
+template <typename Y>
+struct allocator_trait<async_access_t, Y> {
+  public:
+	// the results are deduced, so that only the callers need the definition of `completion_token`.
+	template <typename T>
+	auto allocate_async(size_t count = 1, size_t bytes = sizeof(T)) {
+		return ((Y*)(this))->resource()->allocate_async(bytes * count, alignof(T));
+	}
+
+	template <typename T>
+	auto deallocate_async(T* object, size_t count = 1, size_t bytes = sizeof(T)) {
+		return ((Y*)(this))->resource()->deallocate_async(object, bytes * count, alignof(T));
+	}
+
+	/**
+	 * \brief Copies `count` elements from the host at `source` to the resource's memory at `destination`.
+	 */
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	auto write_async(T* destination, T const* source, size_t count = 1) {
+		return ((Y*)(this))->resource()->write_async(destination, source, sizeof(T) * count);
+	}
+
+	/**
+	 * \brief Reads `count` elements of the resource's memory at `source` back to the host at `destination`.
+	 */
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	auto read_async(T* destination, T const* source, size_t count = 1) {
+		return ((Y*)(this))->resource()->read_async(destination, source, sizeof(T) * count);
+	}
 };
 }	 // namespace psl::traits
 #pragma endregion definition
@@ -169,10 +331,33 @@ bool allocator_trait<basic_allocation, Y>::deallocate(T* object, size_t bytes) {
 	return memoryResource->deallocate(object, bytes, alignof(T));
 }
 
+template <typename Y>
+template <typename T>
+size_t allocator_trait<basic_allocation, Y>::allocate_batch(T** objects, size_t count, size_t bytes) {
+	auto* memoryResource = ((Y*)(this))->resource();
+	return memoryResource->allocate_batch(bytes, alignof(T), count, (void**)objects);
+}
+
+template <typename Y>
+template <typename T>
+bool allocator_trait<basic_allocation, Y>::deallocate_batch(T* const* objects, size_t count, size_t bytes) {
+	auto* memoryResource = ((Y*)(this))->resource();
+	return memoryResource->deallocate_batch((void* const*)objects, count, bytes, alignof(T));
+}
+
+template <typename Y>
+template <typename T>
+alloc_results<T> allocator_trait<reallocate_able_t, Y>::reallocate(T* object, size_t count, size_t bytes) {
+	auto* memoryResource = ((Y*)(this))->resource();
+	return static_cast<alloc_results<T>>(memoryResource->reallocate(object, bytes, count, alignof(T)));
+}
+
 template <typename Y>
 alloc_results<void> memory_resource_trait<basic_allocation, Y>::allocate(size_t size, size_t alignment) {
 	PSL_CONTRACT_EXCEPT_IF(alignment == 0, "alignment value of 0 is not allowed, 1 is the minimum");
 	auto res = do_allocate(size, alignment);
+	if constexpr(HasTrait<Y, allocation_statistics_t>)
+		((Y*)this)->record_allocation(size, res);
 	PSL_CONTRACT_EXCEPT_IF(res && (std::uintptr_t)res.tail % ((Y const*)this)->alignment() != 0,
 						   "implementation of abstract region does not satisfy the requirements");
 	return res;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <type_traits>
 
 #include <psl/allocator.hpp>
@@ -39,6 +41,20 @@ struct allow_instability_t : _priv::id_token<allow_instability_t> {
 inline constexpr allow_instability_t allow_instability {allow_instability_t::identifier::token};
 
 
+/**
+ * \brief Array setting that makes the array pass its allocator on to the elements it constructs.
+ * \details When enabled, `emplace_back` and `resize` hand the array's allocator to every element that accepts it as
+ * its last constructor argument (such as a `psl::array` with the same allocator type), so that nested containers
+ * source their storage from the same allocator as the outer one.
+ */
+template <bool Value>
+struct scoped_allocator {
+	inline constexpr static bool value = Value;
+};
+
+template <typename T>
+concept IsScopedAllocator = std::is_same_v<T, scoped_allocator<true>> || std::is_same_v<T, scoped_allocator<false>>;
+
 namespace _priv {
 	template <typename T, psl::bytes_t Value>
 	consteval size_t get_sbo_size() {
@@ -63,15 +79,19 @@ namespace settings {
 	 * \tparam Stability Either keep_stability_t or allow_instability_t (default).
 	 * \tparam SBOExtent SBO max size
 	 * \tparam SBOAlias Should the SBO alias its internal storage with external storage (pointer)?
+	 * \tparam ScopedAllocator Should the array pass its allocator on to the elements it constructs? See
+	 * `psl::scoped_allocator`.
 	 * \note if the arrays's extent is lower than
 	 */
-	template <typename Allocator	 = default_t,
-			  typename Stability	 = default_t,
-			  psl::bytes_t SBOExtent = default_sbo_size,
-			  IsSBOAlias SBOAlias	 = sbo_alias<false>>
+	template <typename Allocator				= default_t,
+			  typename Stability				= default_t,
+			  psl::bytes_t SBOExtent			= default_sbo_size,
+			  IsSBOAlias SBOAlias				= sbo_alias<false>,
+			  IsScopedAllocator ScopedAllocator = scoped_allocator<false>>
 	struct array {
 		using allocator_type = override_or_default_t<Allocator, config::default_allocator_t>;
 		using stability_type = override_or_default_t<Stability, allow_instability_t>;
+		inline constexpr static bool propagate_allocator = ScopedAllocator::value;
 
 		template <typename T, size_t Extent>
 		using sbo_alias = std::conditional_t<Extent <= _priv::get_sbo_size<T, SBOExtent>(), sbo_alias<true>, SBOAlias>;
@@ -85,13 +105,44 @@ namespace settings {
 namespace _priv {
 	template <typename T>
 	struct is_array_settings_t : std::false_type {};
-	template <typename Allocator, typename Stability, ::psl::bytes_t SBOExtent, IsSBOAlias SBOAlias>
-	struct is_array_settings_t<settings::array<Allocator, Stability, SBOExtent, SBOAlias>> : std::true_type {};
+	template <typename Allocator,
+			  typename Stability,
+			  ::psl::bytes_t SBOExtent,
+			  IsSBOAlias SBOAlias,
+			  IsScopedAllocator ScopedAllocator>
+	struct is_array_settings_t<settings::array<Allocator, Stability, SBOExtent, SBOAlias, ScopedAllocator>>
+		: std::true_type {};
 }	 // namespace _priv
 
 template <typename T>
 concept IsArraySettings = _priv::is_array_settings_t<std::remove_cvref_t<T>>::value;
 
+namespace _priv {
+	/**
+	 * \brief Satisfied when the array can construct an element without arguments, on its own or with the array's
+	 * allocator (see `psl::scoped_allocator`).
+	 */
+	template <typename T, typename Settings>
+	concept IsArrayDefaultConstructible =
+	  (Settings::propagate_allocator && std::is_constructible_v<T, typename Settings::allocator_type const&>) ||
+	  std::is_constructible_v<T>;
+
+	/**
+	 * \brief Clears the array when it goes out of scope, unless it was dismissed by resetting `array`.
+	 * \details Guards the constructors that fill the array one element at a time, so that the elements that were
+	 * already constructed are destroyed when constructing one of the others throws.
+	 */
+	template <typename Array>
+	struct array_clear_guard {
+		constexpr ~array_clear_guard() {
+			if(array)
+				array->clear();
+		}
+
+		Array* array;
+	};
+}	 // namespace _priv
+
 /**
  * \brief Contiguous storage container type
  * \details This container specializes in storing items in contiguous memory. Optionally a max extent can be
@@ -127,6 +178,31 @@ class array {
 	using reverse_iterator		 = psl::contiguous_range_iterator<value_type, -1>;
 	using const_reverse_iterator = psl::contiguous_range_iterator<value_type const, -1>;
 
+	constexpr array() = default;
+	/**
+	 * \brief Constructs an empty array that will source its (non-SBO) storage from the given allocator.
+	 */
+	constexpr explicit array(allocator_type const& allocator) : m_Storage(allocator) {}
+	constexpr array(array const& other) : array(other, other.m_Storage.m_Allocator) {}
+	/**
+	 * \brief Copies the elements of `other` into storage sourced from the given allocator.
+	 */
+	constexpr array(array const& other, allocator_type const& allocator);
+	constexpr array(array&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+		: m_Storage(other.m_Storage.m_Allocator) {
+		take(std::move(other));
+	}
+	/**
+	 * \brief Moves the elements of `other` into storage sourced from the given allocator.
+	 */
+	constexpr array(array&& other, allocator_type const& allocator);
+	constexpr ~array() { clear(); }
+
+	constexpr auto operator=(array const& other) -> array&;
+	constexpr auto operator=(array&& other) -> array&;
+
+	constexpr auto get_allocator() const noexcept -> allocator_type const& { return m_Storage.m_Allocator; }
+
 	constexpr auto operator[](size_type index) noexcept -> reference { return m_Storage[index]; }
 	constexpr auto operator[](size_type index) const noexcept -> const_reference { return m_Storage[index]; }
 
@@ -177,7 +253,7 @@ class array {
 
 	constexpr auto pop_back() -> void;
 	constexpr auto resize(size_type count) -> void
-		requires std::is_constructible_v<value_type>;
+		requires _priv::IsArrayDefaultConstructible<value_type, Settings>;
 	constexpr auto resize(size_type count, value_type const& value) -> void;
 	constexpr auto swap(array& other) noexcept(/* see below */ false) -> void;
 
@@ -212,6 +288,16 @@ class array {
 	}
 
   private:
+	/**
+	 * \brief Constructs an element in place, handing it the array's allocator when the settings propagate it and the
+	 * element accepts it as its last constructor argument.
+	 */
+	template <typename... Args>
+	constexpr auto construct_element(pointer location, Args&&... args) -> void;
+	/**
+	 * \brief Takes over the elements of `other`, this array has to be empty and use its inline storage.
+	 */
+	constexpr auto take(array&& other) -> void;
 	constexpr auto calculate_growth_for(size_type count) const noexcept(!config::exceptions) -> size_type;
 	constexpr auto grow_if_necessary(size_type newElements = 1) -> void;
 	dynamic_sbo_storage<T,
@@ -243,6 +329,31 @@ class array<T, dynamic_extent, Settings> {
 	using reverse_iterator		 = psl::contiguous_range_iterator<value_type, -1>;
 	using const_reverse_iterator = psl::contiguous_range_iterator<value_type const, -1>;
 
+	constexpr array() = default;
+	/**
+	 * \brief Constructs an empty array that will source its (non-SBO) storage from the given allocator.
+	 */
+	constexpr explicit array(allocator_type const& allocator) : m_Storage(allocator) {}
+	constexpr array(array const& other) : array(other, other.m_Storage.m_Allocator) {}
+	/**
+	 * \brief Copies the elements of `other` into storage sourced from the given allocator.
+	 */
+	constexpr array(array const& other, allocator_type const& allocator);
+	constexpr array(array&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+		: m_Storage(other.m_Storage.m_Allocator) {
+		take(std::move(other));
+	}
+	/**
+	 * \brief Moves the elements of `other` into storage sourced from the given allocator.
+	 */
+	constexpr array(array&& other, allocator_type const& allocator);
+	constexpr ~array() { clear(); }
+
+	constexpr auto operator=(array const& other) -> array&;
+	constexpr auto operator=(array&& other) -> array&;
+
+	constexpr auto get_allocator() const noexcept -> allocator_type const& { return m_Storage.m_Allocator; }
+
 	constexpr auto operator[](size_type index) noexcept -> reference { return m_Storage[index]; }
 	constexpr auto operator[](size_type index) const noexcept -> const_reference { return m_Storage[index]; }
 
@@ -280,7 +391,7 @@ class array<T, dynamic_extent, Settings> {
 
 	constexpr auto pop_back() -> void;
 	constexpr auto resize(size_type count) -> void
-		requires std::is_constructible_v<value_type>;
+		requires _priv::IsArrayDefaultConstructible<value_type, Settings>;
 	constexpr auto resize(size_type count, value_type const& value) -> void;
 	constexpr auto swap(array& other) noexcept(/* see below */ false) -> void;
 
@@ -315,6 +426,16 @@ class array<T, dynamic_extent, Settings> {
 	}
 
   private:
+	/**
+	 * \brief Constructs an element in place, handing it the array's allocator when the settings propagate it and the
+	 * element accepts it as its last constructor argument.
+	 */
+	template <typename... Args>
+	constexpr auto construct_element(pointer location, Args&&... args) -> void;
+	/**
+	 * \brief Takes over the elements of `other`, this array has to be empty and use its inline storage.
+	 */
+	constexpr auto take(array&& other) -> void;
 	constexpr auto calculate_growth_for(size_type count) const noexcept -> size_type;
 	constexpr auto grow_if_necessary(size_type newElements = 1) -> void;
 	dynamic_sbo_storage<T,
@@ -391,9 +512,12 @@ constexpr auto psl::array<T, Extent, Settings>::calculate_growth_for(size_type c
 
 template <typename T, size_t Extent, IsArraySettings Settings>
 constexpr void psl::array<T, Extent, Settings>::resize(size_type count)
-	requires std::is_constructible_v<value_type>
+	requires _priv::IsArrayDefaultConstructible<value_type, Settings>
 {
 	PSL_EXCEPT_IF(count > max_size(), overallocation);
+	// the storage keeps its memory region when it shrinks inline, so the dropped elements are destroyed up front.
+	for(auto i = count; i < m_Storage.m_Size; ++i) (m_Storage.data() + i)->~value_type();
+	m_Storage.m_Size = std::min(m_Storage.m_Size, count);
 	m_Storage.reallocate(count, [newSize = count](pointer oldData, pointer newData, size_type oldSize) {
 		auto size = std::min(oldSize, newSize);
 		if(oldData != newData) {
@@ -411,7 +535,7 @@ constexpr void psl::array<T, Extent, Settings>::resize(size_type count)
 
 	// run the remaining constructors in the new memory region
 	pointer ptr = m_Storage.data();
-	for(auto i = m_Storage.m_Size; i < count; ++i) new(ptr + i) value_type();
+	for(auto i = m_Storage.m_Size; i < count; ++i) construct_element(ptr + i);
 
 	m_Storage.m_Size = count;
 }
@@ -420,6 +544,16 @@ constexpr void psl::array<T, Extent, Settings>::resize(size_type count)
 template <typename T, size_t Extent, IsArraySettings Settings>
 constexpr void psl::array<T, Extent, Settings>::resize(size_type count, value_type const& value) {
 	PSL_EXCEPT_IF(count > max_size(), overallocation);
+	if(count > m_Storage.m_Size && std::less_equal<> {}(m_Storage.data(), std::addressof(value)) &&
+	   std::less<> {}(std::addressof(value), m_Storage.data() + m_Storage.m_Size)) {
+		// `value` is one of the elements, which are moved to a new memory region below.
+		value_type copy(value);
+		resize(count, copy);
+		return;
+	}
+	// the storage keeps its memory region when it shrinks inline, so the dropped elements are destroyed up front.
+	for(auto i = count; i < m_Storage.m_Size; ++i) (m_Storage.data() + i)->~value_type();
+	m_Storage.m_Size = std::min(m_Storage.m_Size, count);
 	m_Storage.reallocate(count, [newSize = count](pointer oldData, pointer newData, size_type oldSize) {
 		auto size = std::min(oldSize, newSize);
 		if(oldData != newData) {
@@ -437,7 +571,7 @@ constexpr void psl::array<T, Extent, Settings>::resize(size_type count, value_ty
 
 	// run the remaining constructors in the new memory region
 	pointer ptr = m_Storage.data();
-	for(auto i = m_Storage.m_Size; i < count; ++i) new(ptr + i) value_type(value);
+	for(auto i = m_Storage.m_Size; i < count; ++i) construct_element(ptr + i, value);
 
 	m_Storage.m_Size = count;
 }
@@ -477,11 +611,77 @@ template <typename... Args>
 constexpr auto psl::array<T, Extent, Settings>::emplace_back(Args&&... args) -> reference {
 	grow_if_necessary();
 	pointer ptr = m_Storage.data() + m_Storage.size();
-	new(ptr) value_type(std::forward<Args>(args)...);
+	construct_element(ptr, std::forward<Args>(args)...);
 	++m_Storage.m_Size;
 	return *ptr;
 }
 
+template <typename T, size_t Extent, IsArraySettings Settings>
+constexpr psl::array<T, Extent, Settings>::array(array const& other, allocator_type const& allocator)
+	: m_Storage(allocator) {
+	_priv::array_clear_guard<array> guard {this};
+	reserve(other.size());
+	for(auto const& value : other) emplace_back(value);
+	guard.array = nullptr;
+}
+
+template <typename T, size_t Extent, IsArraySettings Settings>
+constexpr psl::array<T, Extent, Settings>::array(array&& other, allocator_type const& allocator)
+	: m_Storage(allocator) {
+	_priv::array_clear_guard<array> guard {this};
+	reserve(other.size());
+	for(auto& value : other) emplace_back(std::move(value));
+	guard.array = nullptr;
+	other.clear();
+}
+
+template <typename T, size_t Extent, IsArraySettings Settings>
+constexpr auto psl::array<T, Extent, Settings>::operator=(array const& other) -> array& {
+	if(this != &other)
+		*this = array {other, m_Storage.m_Allocator};
+	return *this;
+}
+
+template <typename T, size_t Extent, IsArraySettings Settings>
+constexpr auto psl::array<T, Extent, Settings>::operator=(array&& other) -> array& {
+	if(this != &other) {
+		clear();
+		if(m_Storage.m_Allocator == other.m_Storage.m_Allocator) {
+			m_Storage.deallocate();
+			take(std::move(other));
+		} else {
+			// the storage of `other` belongs to another resource, so only its elements can be moved over.
+			reserve(other.size());
+			for(auto& value : other) emplace_back(std::move(value));
+			other.clear();
+		}
+	}
+	return *this;
+}
+
+template <typename T, size_t Extent, IsArraySettings Settings>
+template <typename... Args>
+constexpr auto psl::array<T, Extent, Settings>::construct_element(pointer location, Args&&... args) -> void {
+	if constexpr(Settings::propagate_allocator && std::is_constructible_v<value_type, Args..., allocator_type const&>)
+		new(location) value_type(std::forward<Args>(args)..., m_Storage.m_Allocator);
+	else
+		new(location) value_type(std::forward<Args>(args)...);
+}
+
+template <typename T, size_t Extent, IsArraySettings Settings>
+constexpr auto psl::array<T, Extent, Settings>::take(array&& other) -> void {
+	if(other.is_stored_inlined()) {
+		// elements in the inline storage cannot change owner, so they are moved one by one.
+		for(auto& value : other) new(m_Storage.data() + m_Storage.m_Size++) value_type(std::move(value));
+		other.clear();
+		return;
+	}
+	m_Storage.m_Storage.ext = other.m_Storage.m_Storage.ext;
+	m_Storage.m_Capacity	= other.m_Storage.m_Capacity;
+	m_Storage.m_Size		= other.m_Storage.m_Size;
+	other.m_Storage.reset_to_capacity();
+}
+
 
 template <typename T, size_t Extent, IsArraySettings Settings>
 constexpr void psl::array<T, Extent, Settings>::shrink_to_fit() {
@@ -608,8 +808,11 @@ constexpr auto psl::array<T, psl::dynamic_extent, Settings>::calculate_growth_fo
 
 template <typename T, IsArraySettings Settings>
 constexpr void psl::array<T, psl::dynamic_extent, Settings>::resize(size_type count)
-	requires std::is_constructible_v<value_type>
+	requires _priv::IsArrayDefaultConstructible<value_type, Settings>
 {
+	// the storage keeps its memory region when it shrinks inline, so the dropped elements are destroyed up front.
+	for(auto i = count; i < m_Storage.m_Size; ++i) (m_Storage.data() + i)->~value_type();
+	m_Storage.m_Size = std::min(m_Storage.m_Size, count);
 	m_Storage.reallocate(count, [newSize = count](pointer oldData, pointer newData, size_type oldSize) {
 		auto size = std::min(oldSize, newSize);
 		if(oldData != newData) {
@@ -627,7 +830,7 @@ constexpr void psl::array<T, psl::dynamic_extent, Settings>::resize(size_type co
 
 	// run the remaining constructors in the new memory region
 	pointer ptr = m_Storage.data();
-	for(auto i = m_Storage.m_Size; i < count; ++i) new(ptr + i) value_type();
+	for(auto i = m_Storage.m_Size; i < count; ++i) construct_element(ptr + i);
 
 	m_Storage.m_Size = count;
 }
@@ -635,6 +838,16 @@ constexpr void psl::array<T, psl::dynamic_extent, Settings>::resize(size_type co
 
 template <typename T, IsArraySettings Settings>
 constexpr void psl::array<T, psl::dynamic_extent, Settings>::resize(size_type count, value_type const& value) {
+	if(count > m_Storage.m_Size && std::less_equal<> {}(m_Storage.data(), std::addressof(value)) &&
+	   std::less<> {}(std::addressof(value), m_Storage.data() + m_Storage.m_Size)) {
+		// `value` is one of the elements, which are moved to a new memory region below.
+		value_type copy(value);
+		resize(count, copy);
+		return;
+	}
+	// the storage keeps its memory region when it shrinks inline, so the dropped elements are destroyed up front.
+	for(auto i = count; i < m_Storage.m_Size; ++i) (m_Storage.data() + i)->~value_type();
+	m_Storage.m_Size = std::min(m_Storage.m_Size, count);
 	m_Storage.reallocate(count, [newSize = count](pointer oldData, pointer newData, size_type oldSize) {
 		auto size = std::min(oldSize, newSize);
 		if(oldData != newData) {
@@ -652,7 +865,7 @@ constexpr void psl::array<T, psl::dynamic_extent, Settings>::resize(size_type co
 
 	// run the remaining constructors in the new memory region
 	pointer ptr = m_Storage.data();
-	for(auto i = m_Storage.m_Size; i < count; ++i) new(ptr + i) value_type(value);
+	for(auto i = m_Storage.m_Size; i < count; ++i) construct_element(ptr + i, value);
 
 	m_Storage.m_Size = count;
 }
@@ -690,11 +903,78 @@ template <typename... Args>
 constexpr auto psl::array<T, psl::dynamic_extent, Settings>::emplace_back(Args&&... args) -> reference {
 	grow_if_necessary();
 	pointer ptr = m_Storage.data() + m_Storage.size();
-	new(ptr) value_type(std::forward<Args>(args)...);
+	construct_element(ptr, std::forward<Args>(args)...);
 	++m_Storage.m_Size;
 	return *ptr;
 }
 
+template <typename T, IsArraySettings Settings>
+constexpr psl::array<T, psl::dynamic_extent, Settings>::array(array const& other, allocator_type const& allocator)
+	: m_Storage(allocator) {
+	_priv::array_clear_guard<array> guard {this};
+	reserve(other.size());
+	for(auto const& value : other) emplace_back(value);
+	guard.array = nullptr;
+}
+
+template <typename T, IsArraySettings Settings>
+constexpr psl::array<T, psl::dynamic_extent, Settings>::array(array&& other, allocator_type const& allocator)
+	: m_Storage(allocator) {
+	_priv::array_clear_guard<array> guard {this};
+	reserve(other.size());
+	for(auto& value : other) emplace_back(std::move(value));
+	guard.array = nullptr;
+	other.clear();
+}
+
+template <typename T, IsArraySettings Settings>
+constexpr auto psl::array<T, psl::dynamic_extent, Settings>::operator=(array const& other) -> array& {
+	if(this != &other)
+		*this = array {other, m_Storage.m_Allocator};
+	return *this;
+}
+
+template <typename T, IsArraySettings Settings>
+constexpr auto psl::array<T, psl::dynamic_extent, Settings>::operator=(array&& other) -> array& {
+	if(this != &other) {
+		clear();
+		if(m_Storage.m_Allocator == other.m_Storage.m_Allocator) {
+			m_Storage.deallocate();
+			take(std::move(other));
+		} else {
+			// the storage of `other` belongs to another resource, so only its elements can be moved over.
+			reserve(other.size());
+			for(auto& value : other) emplace_back(std::move(value));
+			other.clear();
+		}
+	}
+	return *this;
+}
+
+template <typename T, IsArraySettings Settings>
+template <typename... Args>
+constexpr auto psl::array<T, psl::dynamic_extent, Settings>::construct_element(pointer location, Args&&... args)
+  -> void {
+	if constexpr(Settings::propagate_allocator && std::is_constructible_v<value_type, Args..., allocator_type const&>)
+		new(location) value_type(std::forward<Args>(args)..., m_Storage.m_Allocator);
+	else
+		new(location) value_type(std::forward<Args>(args)...);
+}
+
+template <typename T, IsArraySettings Settings>
+constexpr auto psl::array<T, psl::dynamic_extent, Settings>::take(array&& other) -> void {
+	if(other.is_stored_inlined()) {
+		// elements in the inline storage cannot change owner, so they are moved one by one.
+		for(auto& value : other) new(m_Storage.data() + m_Storage.m_Size++) value_type(std::move(value));
+		other.clear();
+		return;
+	}
+	m_Storage.m_Storage.ext = other.m_Storage.m_Storage.ext;
+	m_Storage.m_Capacity	= other.m_Storage.m_Capacity;
+	m_Storage.m_Size		= other.m_Storage.m_Size;
+	other.m_Storage.reset_to_capacity();
+}
+
 
 template <typename T, IsArraySettings Settings>
 constexpr void psl::array<T, psl::dynamic_extent, Settings>::shrink_to_fit() {
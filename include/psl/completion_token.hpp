@@ -0,0 +1,143 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <psl/exceptions.hpp>
+#include <utility>
+
+namespace psl {
+template <typename T>
+class completion_token;
+
+template <typename T>
+class completion_source;
+
+namespace _priv {
+	template <typename T>
+	struct completion_state {
+		std::mutex mutex {};
+		std::condition_variable condition {};
+		std::optional<T> value {};
+		std::coroutine_handle<> continuation {};
+	};
+}	 // namespace _priv
+
+/**
+ * \brief Handle to the result of an asynchronous operation, which is completed by its `completion_source`.
+ * \details The result can be polled with `ready()`, waited on with `wait()`/`get()`, or awaited from a coroutine, in
+ * which case the coroutine resumes on the thread that completes the operation. Copies of a token refer to the same
+ * result, but only one coroutine can await it.
+ * \warning The awaiting coroutine runs on the completing thread until it suspends again, so it must not block on
+ * operations that only that thread can complete (such as `wait()` or `get()` on a later operation of the same
+ * `simulated_device_resource`), which deadlocks.
+ *
+ * \tparam T result type of the operation.
+ */
+template <typename T>
+class completion_token {
+	friend class completion_source<T>;
+	completion_token(std::shared_ptr<_priv::completion_state<T>> state) noexcept : m_State(std::move(state)) {}
+
+  public:
+	using value_type = T;
+
+	completion_token() noexcept = default;
+
+	/**
+	 * \returns false for a default constructed token, which has no operation to wait on.
+	 */
+	bool valid() const noexcept { return m_State != nullptr; }
+
+	/**
+	 * \returns true once the operation completed.
+	 */
+	bool ready() const {
+		PSL_EXCEPT_IF(!valid(), std::runtime_error, "the completion token has no operation");
+		std::lock_guard lock {m_State->mutex};
+		return m_State->value.has_value();
+	}
+
+	/**
+	 * \brief Blocks until the operation completed.
+	 */
+	void wait() const {
+		PSL_EXCEPT_IF(!valid(), std::runtime_error, "the completion token has no operation");
+		std::unique_lock lock {m_State->mutex};
+		m_State->condition.wait(lock, [this] { return m_State->value.has_value(); });
+	}
+
+	/**
+	 * \brief Blocks until the operation completed, or until `timeout` elapsed.
+	 * \returns true when the operation completed.
+	 */
+	template <typename Rep, typename Period>
+	bool wait_for(std::chrono::duration<Rep, Period> const& timeout) const {
+		PSL_EXCEPT_IF(!valid(), std::runtime_error, "the completion token has no operation");
+		std::unique_lock lock {m_State->mutex};
+		return m_State->condition.wait_for(lock, timeout, [this] { return m_State->value.has_value(); });
+	}
+
+	/**
+	 * \returns the result of the operation, blocks until it completed.
+	 */
+	T const& get() const {
+		wait();
+		return *m_State->value;
+	}
+
+	bool await_ready() const { return ready(); }
+
+	/**
+	 * \returns false when the operation completed in the meantime, so that the coroutine continues right away.
+	 */
+	bool await_suspend(std::coroutine_handle<> continuation) {
+		PSL_EXCEPT_IF(!valid(), std::runtime_error, "the completion token has no operation");
+		std::lock_guard lock {m_State->mutex};
+		if(m_State->value.has_value())
+			return false;
+		PSL_EXCEPT_IF((bool)m_State->continuation, std::runtime_error, "the completion token is already awaited");
+		m_State->continuation = continuation;
+		return true;
+	}
+
+	T const& await_resume() const { return *m_State->value; }
+
+  private:
+	std::shared_ptr<_priv::completion_state<T>> m_State {};
+};
+
+/**
+ * \brief Producer side of a `completion_token`, which completes the operation.
+ *
+ * \tparam T result type of the operation.
+ */
+template <typename T>
+class completion_source {
+  public:
+	completion_source() : m_State(std::make_shared<_priv::completion_state<T>>()) {}
+
+	completion_token<T> token() const noexcept { return {m_State}; }
+
+	/**
+	 * \brief Stores the result, wakes the waiting threads, and resumes the awaiting coroutine on this thread.
+	 */
+	void complete(T value) {
+		std::coroutine_handle<> continuation {};
+		{
+			std::lock_guard lock {m_State->mutex};
+			PSL_EXCEPT_IF(m_State->value.has_value(), std::runtime_error, "the operation was already completed");
+			m_State->value.emplace(std::move(value));
+			continuation = std::exchange(m_State->continuation, {});
+		}
+		m_State->condition.notify_all();
+		if(continuation)
+			continuation.resume();
+	}
+
+  private:
+	std::shared_ptr<_priv::completion_state<T>> m_State {};
+};
+}	 // namespace psl
@@ -0,0 +1,63 @@
+#pragma once
+#include <psl/allocator.hpp>
+
+namespace psl::_priv {
+template <bool Condition, typename Trait, typename Resource>
+struct append_trait {
+	using type = Resource;
+};
+
+template <typename Trait, typename... Traits>
+struct append_trait<true, Trait, psl::traited_memory_resource<Traits...>> {
+	using type = psl::traited_memory_resource<Traits..., Trait>;
+};
+
+/**
+ * \brief The `traited_memory_resource` a resource that composes `Resources` derives from.
+ * \details A composed resource is only shareable, or size queryable, when all of its inputs are. Mixing physically
+ * and virtually allocated resources is not supported, as the allocations could not be used in the same way.
+ */
+template <IsMemoryResource... Resources>
+struct combined_traits {
+	static_assert((traits::IsVirtuallyAllocated<Resources> && ...) || (traits::IsPhysicallyAllocated<Resources> && ...),
+				  "physically and virtually allocated resources cannot be combined");
+
+	inline constexpr static bool shareable {(traits::IsShareable<Resources> && ...)};
+	inline constexpr static bool size_queryable {(traits::IsSizeQueryable<Resources> && ...)};
+	inline constexpr static bool virtually_allocated {(traits::IsVirtuallyAllocated<Resources> && ...)};
+
+	using type = typename append_trait<
+	  virtually_allocated,
+	  psl::traits::physically_allocated_t<false>,
+	  typename append_trait<size_queryable,
+							psl::traits::queryable_size_t,
+							psl::traited_memory_resource<psl::traits::shareable_t<shareable>,
+														 psl::traits::basic_allocation>>::type>::type;
+};
+
+template <typename Derived, typename Base, bool SizeQueryable>
+class combined_resource_base : public Base {
+  public:
+	using Base::Base;
+};
+
+template <typename Derived, typename Base>
+class combined_resource_base<Derived, Base, true> : public Base {
+  public:
+	using Base::Base;
+
+	/**
+	 * \returns the sum of the sizes of the composed resources.
+	 */
+	size_t size() const noexcept override { return static_cast<Derived const*>(this)->combined_size(); }
+};
+
+/**
+ * \brief Base class of the resources that compose `Resources`, derives from the `combined_traits` resource type.
+ * \details When the result is size queryable, `Derived` has to implement `combined_size()`.
+ */
+template <typename Derived, IsMemoryResource... Resources>
+using combined_resource_t = combined_resource_base<Derived,
+												   typename combined_traits<Resources...>::type,
+												   combined_traits<Resources...>::size_queryable>;
+}	 // namespace psl::_priv
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+
+namespace psl::_priv::heap {
+/**
+ * \brief Allocates `size` bytes aligned to `alignment` from the C heap.
+ * \returns the start of the block, or nullptr on failure.
+ */
+void* allocate(size_t size, size_t alignment) noexcept;
+
+/**
+ * \brief Frees a block of `allocate`, with the same alignment it was allocated with.
+ */
+void deallocate(void* address, size_t alignment) noexcept;
+
+/**
+ * \returns the amount of bytes the block at `address` can hold, which is at least the `size` it was allocated with.
+ * Platforms that cannot query it return `size`.
+ */
+size_t usable_size(void* address, size_t size, size_t alignment) noexcept;
+}	 // namespace psl::_priv::heap
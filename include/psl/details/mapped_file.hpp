@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace psl::_priv::mapped_file {
+/**
+ * \brief A file that is mapped into the address space, shared with the file (writes end up in the file).
+ */
+struct mapping_t {
+	void* address {nullptr};
+	size_t size {0};
+	std::intptr_t file {-1};	 // native file handle (a file descriptor, or a `HANDLE` on windows).
+	std::intptr_t mapping {0};	 // native handle of the mapping object, only used on windows.
+};
+
+/**
+ * \returns true when a file exists at `path`.
+ */
+bool exists(char const* path) noexcept;
+
+/**
+ * \brief Maps the file at `path` for reading and writing.
+ * \param[out] result receives the mapping.
+ * \param[in] path location of the file.
+ * \param[in] size when non-zero, the file is created (or truncated) with this size, otherwise the existing file is
+ * mapped as a whole.
+ * \returns false when the file could not be opened, created or mapped.
+ */
+bool map(mapping_t& result, char const* path, size_t size) noexcept;
+
+/**
+ * \brief Maps the named shared memory object `name` for reading and writing.
+ * \details Portable names start with a `/`, and contain no other slashes.
+ * \param[out] result receives the mapping.
+ * \param[in] name name of the shared memory object.
+ * \param[in] size when non-zero, a new object of this size is created (which fails when the name is in use),
+ * otherwise the existing object is mapped as a whole.
+ * \returns false when the object could not be opened, created or mapped.
+ */
+bool map_shared(mapping_t& result, char const* name, size_t size) noexcept;
+
+/**
+ * \brief Removes the name of a shared memory object, existing mappings of the object stay valid.
+ * \note Named objects disappear with their last handle on windows, so this has no effect there.
+ */
+bool remove_shared(char const* name) noexcept;
+
+/**
+ * \brief Writes the modified pages of the range back to the file, and waits for the writes to complete.
+ */
+bool flush(mapping_t const& mapping, void* address, size_t size) noexcept;
+
+/**
+ * \brief Unmaps the file and closes its handles, modifications that were not flushed are written back lazily.
+ */
+void unmap(mapping_t& mapping) noexcept;
+}	 // namespace psl::_priv::mapped_file
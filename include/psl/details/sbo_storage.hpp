@@ -1,6 +1,7 @@
 #pragma once
 #include <array>
 #include <psl/algorithms.hpp>
+#include <psl/allocator_traits.hpp>
 #include <psl/enum.hpp>
 #include <psl/iterators.hpp>
 #include <psl/types.hpp>
@@ -164,13 +165,13 @@ struct dynamic_sbo_storage {
 			PSL_EXCEPT_IF(!res, std::runtime_error, "could not allocate");
 
 			m_Storage.ext = res.data;
-			m_Capacity	  = (pointer)ralign_to((size_type)res.tail, sizeof(value_type)) - m_Storage.ext;
+			m_Capacity	  = capacity_of(res);
 		}
 	}
 
 	constexpr ~dynamic_sbo_storage() {
 		if(!is_stored_inlined()) {
-			m_Allocator.deallocate(m_Storage.ext);
+			m_Allocator.deallocate(m_Storage.ext, m_Capacity * sizeof(value_type));
 		}
 	}
 
@@ -196,7 +197,8 @@ struct dynamic_sbo_storage {
 
 	void deallocate() {
 		if(!is_stored_inlined()) {
-			m_Allocator.deallocate(m_Storage.ext);
+			m_Allocator.deallocate(m_Storage.ext, m_Capacity * sizeof(value_type));
+			reset_to_capacity();
 		}
 		m_Capacity = SBO;
 		m_Size	   = 0;
@@ -208,20 +210,22 @@ struct dynamic_sbo_storage {
 		if constexpr(SBO == 0) {
 			if(size == 0) {
 				move_fn(m_Storage.ext, nullptr, m_Size);
-				m_Allocator.deallocate(m_Storage.ext);
+				m_Allocator.deallocate(m_Storage.ext, m_Capacity * sizeof(value_type));
 
 				m_Storage.ext = nullptr;
 				m_Capacity	  = 0;
 				return;
 			}
+			if(m_Storage.ext && size >= m_Size && try_reallocate(size, move_fn))
+				return;
 			auto res = m_Allocator.template allocate_n<value_type>(size);
 			PSL_EXCEPT_IF(!res, std::runtime_error, "could not allocate");
 
 			move_fn(m_Storage.ext, res.data, m_Size);
-			m_Allocator.deallocate(m_Storage.ext);
+			m_Allocator.deallocate(m_Storage.ext, m_Capacity * sizeof(value_type));
 
 			m_Storage.ext = res.data;
-			m_Capacity	  = (pointer)ralign_to((size_type)res.tail, sizeof(value_type)) - m_Storage.ext;
+			m_Capacity	  = capacity_of(res);
 		} else {
 			if(size <= SBO) {
 				// no change, the minimum capacity is always the SBO size
@@ -232,12 +236,14 @@ struct dynamic_sbo_storage {
 				else {
 					auto storage = m_Storage.ext;
 					move_fn(storage, m_Storage.local.data(), m_Size);
-					m_Allocator.deallocate(storage);
+					m_Allocator.deallocate(storage, m_Capacity * sizeof(value_type));
 					m_Capacity = SBO;
 					if constexpr(!SBOAlias<Alias>)
 						m_Storage.ext = m_Storage.local.data();
 				}
 			} else {
+				if(!is_stored_inlined() && size >= m_Size && try_reallocate(size, move_fn))
+					return;
 				auto res = m_Allocator.template allocate_n<value_type>(size);
 				PSL_EXCEPT_IF(!res, std::runtime_error, "could not allocate");
 
@@ -248,15 +254,46 @@ struct dynamic_sbo_storage {
 				// no change, still in ext storage
 				else {
 					move_fn(m_Storage.ext, res.data, m_Size);
-					m_Allocator.deallocate(m_Storage.ext);
+					m_Allocator.deallocate(m_Storage.ext, m_Capacity * sizeof(value_type));
 				}
 
 				m_Storage.ext = res.data;
-				m_Capacity	  = (pointer)ralign_to((size_type)res.tail, sizeof(value_type)) - m_Storage.ext;
+				m_Capacity	  = capacity_of(res);
 			}
 		}
 	}
 
+	/**
+	 * \brief Resizes the external storage through the allocator's `reallocate`, when it supports it.
+	 * \details Only used when no live elements would be lost (`size >= m_Size`), the resource is free to either grow
+	 * the block in place, or hand out a new block (to which the elements are then moved).
+	 * \returns false when the allocator does not support reallocating, or the reallocation failed.
+	 */
+	template <typename Fn>
+	bool try_reallocate(size_type size, Fn& move_fn) {
+		if constexpr(traits::IsReallocateAble<Allocator>) {
+			auto res = m_Allocator.template reallocate<value_type>(m_Storage.ext, size);
+			if(!res)
+				return false;
+			if(res.data != m_Storage.ext) {
+				move_fn(m_Storage.ext, res.data, m_Size);
+				m_Allocator.deallocate(m_Storage.ext, m_Capacity * sizeof(value_type));
+				m_Storage.ext = res.data;
+			}
+			m_Capacity = capacity_of(res);
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	/**
+	 * \returns the amount of elements that fit in the allocation, including any slack the resource reported.
+	 */
+	static constexpr size_type capacity_of(alloc_results<value_type> const& res) noexcept {
+		return (size_type)(res.tail - (std::byte*)res.data) / sizeof(value_type);
+	}
+
 	constexpr auto begin() noexcept { return iterator {data()}; }
 	constexpr auto end() noexcept { return iterator {data() + m_Size}; }
 	constexpr auto begin() const noexcept { return const_iterator {data()}; }
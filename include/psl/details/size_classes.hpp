@@ -0,0 +1,62 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+namespace psl::_priv {
+/**
+ * \brief Size classes shared by the size segregated memory resources.
+ * \details The classes are spaced in 16 byte increments up to 128 bytes, and in quarter powers of two after that up
+ * to 1024 bytes. Every class is at least as large as a pointer, so free slots can be linked intrusively.
+ */
+struct size_classes {
+	inline constexpr static size_t min_size {16};
+	inline constexpr static size_t max_size {1024};
+	inline constexpr static size_t count {20};
+	inline constexpr static size_t npos {count};
+
+	/**
+	 * \returns the size (in bytes) of the size class at the given index.
+	 */
+	static constexpr size_t size(size_t index) noexcept {
+		if(index < 8)
+			return (index + 1) * 16;
+		index -= 8;
+		return (5 + (index % 4)) << (5 + index / 4);
+	}
+
+	/**
+	 * \returns the natural alignment of the size class, i.e. the largest power of two that divides its size.
+	 */
+	static constexpr size_t alignment(size_t index) noexcept { return size(index) & (~size(index) + 1); }
+
+	/**
+	 * \returns the index of the first size class that can contain `size` bytes, where the slot size is a multiple of
+	 * `alignment`, or `npos` when no such class exists.
+	 * \note sizes between the requested size and the size of the returned class map onto the same class, so the
+	 * class can be recovered at deallocation from any size that was reported back to the user.
+	 */
+	static constexpr size_t index(size_t size, size_t alignment) noexcept {
+		if(size > max_size || alignment > max_size)
+			return npos;
+		size = std::max(size, min_size);
+
+		size_t result {};
+		if(size <= 128) {
+			result = (size + 15) / 16 - 1;
+		} else {
+			auto log2 = (size_t)std::bit_width(size - 1);
+			result	  = 8 + (log2 - 8) * 4 + (((size - 1) >> (log2 - 3)) & 3);
+		}
+
+		for(; result < count; ++result) {
+			if(size_classes::size(result) % alignment == 0)
+				return result;
+		}
+		return npos;
+	}
+};
+
+static_assert(size_classes::size(size_classes::count - 1) == size_classes::max_size);
+static_assert(size_classes::index(size_classes::max_size, 1) == size_classes::count - 1);
+}	 // namespace psl::_priv
@@ -0,0 +1,171 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace psl::_priv {
+/**
+ * \brief Gives every thread that uses an `Owner` its own `Entry`, and hands it back to the owner when the thread exits.
+ * \details The entries are found through a thread local list that is shared by all registries of the same type, the
+ * entry of the last registry that was used is cached, so that looking it up again is a single comparison.
+ * When a thread exits, `Owner::retire(Entry&)` is invoked for every registry it used that is still alive. When the
+ * owner is destroyed it calls `release` first, which detaches the entries of the threads that are still running, the
+ * threads then forget them the next time they register with another owner.
+ * \note `retire` is invoked on the exiting thread, while the owner can be destroyed concurrently on another thread.
+ * Every entry has a lock that is held during both, so that they never overlap.
+ *
+ * \tparam Owner type that is notified when a thread exits.
+ * \tparam Entry default constructible state of every thread.
+ */
+template <typename Owner, typename Entry>
+class thread_registry {
+	struct handle_t {
+		std::mutex lock;	// only guards `registry` against the thread exiting while the owner is destroyed.
+		thread_registry* registry {nullptr};
+		Entry entry {};
+	};
+
+	struct thread_state_t {
+		~thread_state_t() {
+			for(auto& [id, handle] : handles) {
+				std::lock_guard guard {handle->lock};
+				if(handle->registry)
+					handle->registry->retire(*handle);
+			}
+		}
+
+		std::vector<std::pair<size_t, std::shared_ptr<handle_t>>> handles {};
+		size_t last_id {0};
+		handle_t* last {nullptr};
+	};
+
+  public:
+	explicit thread_registry(Owner& owner) noexcept : m_Owner(&owner), m_Id(next_id()) {}
+	~thread_registry() { release([](Entry&) {}); }
+
+	thread_registry(thread_registry const&)			   = delete;
+	thread_registry(thread_registry&&)				   = delete;
+	thread_registry& operator=(thread_registry const&) = delete;
+	thread_registry& operator=(thread_registry&&)	   = delete;
+
+	/**
+	 * \returns the entry of the calling thread, creating it when the thread has none yet.
+	 * \param[in] init invoked with a new entry before it is registered.
+	 */
+	template <typename Init>
+	Entry& local(Init&& init) {
+		auto& state = thread_state();
+		if(state.last_id == m_Id) [[likely]]
+			return state.last->entry;
+
+		auto* handle = find(state);
+		if(!handle) {
+			// forget the handles of owners that have since been destroyed
+			std::erase_if(state.handles, [](auto const& entry) {
+				std::lock_guard guard {entry.second->lock};
+				return entry.second->registry == nullptr;
+			});
+
+			auto created	  = std::make_shared<handle_t>();
+			created->registry = this;
+			init(created->entry);
+			{
+				std::lock_guard guard {m_Lock};
+				m_Handles.emplace_back(created);
+			}
+			handle = created.get();
+			state.handles.emplace_back(m_Id, std::move(created));
+		}
+		state.last_id = m_Id;
+		state.last	  = handle;
+		return handle->entry;
+	}
+
+	Entry& local() { return local([](Entry&) {}); }
+
+	/**
+	 * \returns the entry of the calling thread, or nullptr when it has none.
+	 */
+	Entry* find() noexcept {
+		auto& state = thread_state();
+		if(state.last_id == m_Id) [[likely]]
+			return &state.last->entry;
+
+		auto* handle = find(state);
+		if(!handle)
+			return nullptr;
+		state.last_id = m_Id;
+		state.last	  = handle;
+		return &handle->entry;
+	}
+
+	/**
+	 * \brief Invokes `fn` for the entry of every thread that is registered.
+	 * \note the entries can be used concurrently by their threads.
+	 */
+	template <typename Fn>
+	void for_each(Fn&& fn) {
+		std::lock_guard guard {m_Lock};
+		for(auto& handle : m_Handles) fn(handle->entry);
+	}
+
+	/**
+	 * \brief Detaches the entries of the threads that are still running, invoking `fn` for every one of them.
+	 * \details Called by the owner when it is destroyed, `Owner::retire` is no longer invoked once this returns.
+	 */
+	template <typename Fn>
+	void release(Fn&& fn) {
+		decltype(m_Handles) handles {};
+		{
+			std::lock_guard guard {m_Lock};
+			handles.swap(m_Handles);
+		}
+
+		for(auto& handle : handles) {
+			std::lock_guard guard {handle->lock};
+			if(!handle->registry)
+				continue;
+			fn(handle->entry);
+			handle->registry = nullptr;
+		}
+	}
+
+  private:
+	static size_t next_id() noexcept {
+		static std::atomic<size_t> id {1};
+		return id.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static thread_state_t& thread_state() noexcept {
+		static thread_local thread_state_t state {};
+		return state;
+	}
+
+	handle_t* find(thread_state_t& state) const noexcept {
+		auto it = std::find_if(
+		  state.handles.begin(), state.handles.end(), [id = m_Id](auto const& entry) { return entry.first == id; });
+		return (it == state.handles.end()) ? nullptr : it->second.get();
+	}
+
+	/**
+	 * \brief Hands the entry of an exiting thread back to the owner.
+	 * \note called with the lock of the handle held.
+	 */
+	void retire(handle_t& handle) {
+		m_Owner->retire(handle.entry);
+		{
+			std::lock_guard guard {m_Lock};
+			std::erase_if(m_Handles, [&handle](auto const& entry) { return entry.get() == &handle; });
+		}
+		handle.registry = nullptr;
+	}
+
+	Owner* m_Owner {nullptr};
+	size_t m_Id {0};
+	std::mutex m_Lock {};
+	std::vector<std::shared_ptr<handle_t>> m_Handles {};
+};
+}	 // namespace psl::_priv
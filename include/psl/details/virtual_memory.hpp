@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+
+namespace psl::_priv::virtual_memory {
+/**
+ * \returns the granularity (in bytes) at which address space can be committed and decommitted.
+ */
+size_t page_size() noexcept;
+
+/**
+ * \brief Reserves `size` bytes of address space without backing it with memory, the range is not accessible until
+ * it is committed.
+ * \returns the start of the range, or nullptr on failure.
+ */
+void* reserve(size_t size) noexcept;
+
+/**
+ * \brief Makes the (page aligned) range accessible, memory is backed lazily on first access by the OS.
+ */
+bool commit(void* address, size_t size) noexcept;
+
+/**
+ * \brief Gives the memory backing the (page aligned) range back to the OS, and makes it inaccessible again. The
+ * range stays reserved.
+ */
+bool decommit(void* address, size_t size) noexcept;
+
+/**
+ * \returns the size (in bytes) of the huge pages `map_huge` tries to use.
+ */
+size_t huge_page_size() noexcept;
+
+/**
+ * \brief Maps `size` bytes of committed memory, aligned to `huge_page_size`, and tries to have it backed by huge
+ * pages. Explicit huge pages are tried first, falling back to requesting transparent huge pages on the range, and
+ * finally to normal pages.
+ * \param[in] size size of the range, has to be a multiple of `huge_page_size`.
+ * \param[out] huge set to true when the range was (or was requested to be) backed by huge pages.
+ * \returns the start of the range, or nullptr on failure. The range is freed by `release`.
+ */
+void* map_huge(size_t size, bool& huge) noexcept;
+
+/**
+ * \brief Releases a range previously returned by `reserve` or `map_huge`.
+ */
+bool release(void* address, size_t size) noexcept;
+}	 // namespace psl::_priv::virtual_memory
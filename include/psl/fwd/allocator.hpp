@@ -13,6 +13,10 @@ template <typename... Traits>
 class allocator;
 
 class new_resource;
+class malloc_resource;
+
+template <typename T>
+class completion_token;
 
 /**
  * \brief Result type of an allocation invocation
@@ -51,6 +55,7 @@ struct alloc_results {
 
 namespace psl::traits {
 struct basic_allocation;
+struct allocation_statistics_t;
 
 template <bool Value>
 struct shareable_t;
@@ -0,0 +1,110 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/combined_traits.hpp>
+#include <utility>
+
+namespace psl {
+/**
+ * \brief Spreads the allocations of `Min` up to `Max` bytes over a set of resources, one per `Step` bytes.
+ * \details Bucket `i` serves the allocations of `Min + i * Step` up to `Min + (i + 1) * Step - 1` bytes, so every
+ * `Pool` only sees a narrow range of sizes. Allocations outside of `[Min, Max]` fail, combine the resource with a
+ * `segregator_resource` or `fallback_resource` to serve those. The deallocations are routed on their size, so the
+ * reported `alloc_results::tail` is clamped to the largest size of the bucket, rounded down to the alignment. Sizes are
+ * rounded up to the alignment before they are routed, so that every size between the requested and the reported one
+ * ends up in the same bucket even when `Min` or `Step` are not multiples of the alignment.
+ * The resource has the traits of `Pool`, and every bucket is constructed from the same arguments.
+ *
+ * \tparam Pool resource type of every bucket.
+ * \tparam Min smallest size (in bytes) that is served.
+ * \tparam Max largest size (in bytes) that is served.
+ * \tparam Step size range (in bytes) of every bucket.
+ */
+template <IsMemoryResource Pool, size_t Min, size_t Max, size_t Step>
+	requires(Step > 0 && Min <= Max)
+class bucketizer_resource : public _priv::combined_resource_t<bucketizer_resource<Pool, Min, Max, Step>, Pool> {
+	using base_type = _priv::combined_resource_t<bucketizer_resource<Pool, Min, Max, Step>, Pool>;
+	friend struct _priv::resource_access;
+	friend base_type;
+
+  public:
+	using pool_type = Pool;
+
+	inline constexpr static size_t bucket_count {(Max - Min) / Step + 1};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] args the constructor arguments of every bucket that follow the alignment.
+	 */
+	template <typename... Args>
+	bucketizer_resource(size_t alignment, Args const&... args)
+		: bucketizer_resource(std::make_index_sequence<bucket_count> {}, alignment, args...) {}
+
+	bucketizer_resource(bucketizer_resource const&)			   = delete;
+	bucketizer_resource(bucketizer_resource&&)				   = delete;
+	bucketizer_resource& operator=(bucketizer_resource const&) = delete;
+	bucketizer_resource& operator=(bucketizer_resource&&)	   = delete;
+
+	/**
+	 * \returns the index of the bucket that serves `size`, or `bucket_count` when `size` is out of range.
+	 */
+	static constexpr size_t bucket_index(size_t size) noexcept {
+		return (size < Min || size > Max) ? bucket_count : (size - Min) / Step;
+	}
+
+	Pool& bucket(size_t index) noexcept { return m_Buckets[index]; }
+	Pool const& bucket(size_t index) const noexcept { return m_Buckets[index]; }
+
+  private:
+	template <size_t... Indices, typename... Args>
+	bucketizer_resource(std::index_sequence<Indices...>, size_t alignment, Args const&... args)
+		: base_type(alignment), m_Buckets {((void)Indices, Pool(alignment, args...))...} {}
+
+	static constexpr size_t bucket_max(size_t index) noexcept { return std::min(Min + (index + 1) * Step - 1, Max); }
+
+	size_t route(size_t size) const noexcept { return bucket_index(psl::align_to<size_t>(size, this->alignment())); }
+
+	size_t combined_size() const noexcept {
+		size_t size {0};
+		for(auto const& bucket : m_Buckets) size += bucket.size();
+		return size;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto index = route(size);
+		if(index == bucket_count)
+			return {};
+		auto result = m_Buckets[index].allocate(size, std::lcm(alignment, this->alignment()));
+		if(result)
+			result.tail =
+			  std::min(result.tail, (std::byte*)result.data + psl::ralign_to(bucket_max(index), this->alignment()));
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		auto index = route(size);
+		if(index == bucket_count)
+			return ptr == nullptr;
+		return m_Buckets[index].deallocate(ptr, size, std::lcm(alignment, this->alignment()));
+	}
+
+	size_t do_allocate_batch(size_t size, size_t alignment, size_t count, void** items) override {
+		auto index = route(size);
+		if(index == bucket_count)
+			return 0;
+		return m_Buckets[index].allocate_batch(size, std::lcm(alignment, this->alignment()), count, items);
+	}
+
+	bool do_deallocate_batch(void* const* items, size_t count, size_t size, size_t alignment) override {
+		auto index = route(size);
+		if(index == bucket_count)
+			return false;
+		return m_Buckets[index].deallocate_batch(items, count, size, std::lcm(alignment, this->alignment()));
+	}
+
+	std::array<Pool, bucket_count> m_Buckets;
+};
+}	 // namespace psl
@@ -0,0 +1,218 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+
+namespace psl {
+/**
+ * \brief Binary buddy memory resource over a region reserved from the upstream resource.
+ * \details Blocks are powers of two multiples of `min_block_size`, splitting and merging happen with the block's
+ * buddy (the neighbouring block of the same size). This enables `reallocate` to grow a block in place whenever the
+ * buddies it would absorb are free, which means containers using this resource can often grow without moving their
+ * elements.
+ * The reported `alloc_results::tail` is the end of the block, so containers can make use of the slack.
+ * Requests that don't fit in the region are forwarded to the upstream resource.
+ * \note The resource is not synchronized, use it from one thread at a time.
+ *
+ * \tparam Upstream resource type to source the region from.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class buddy_resource : public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+														   psl::traits::basic_allocation,
+														   psl::traits::reallocate_able_t> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::reallocate_able_t>;
+	friend struct _priv::resource_access;
+
+	struct free_block_t {
+		free_block_t* previous {nullptr};
+		free_block_t* next {nullptr};
+	};
+
+	inline constexpr static std::uint8_t free_flag {0x80};
+	inline constexpr static size_t max_orders {48};
+	inline constexpr static size_t max_region_alignment {4096};
+
+  public:
+	using upstream_type = Upstream;
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] capacity size of the region in bytes, this gets rounded down to a power of 2.
+	 * \param[in] min_block_size size of the smallest block, this gets rounded up to a power of 2.
+	 * \param[in] upstream resource to source the region from.
+	 */
+	buddy_resource(size_t alignment,
+				   size_t capacity,
+				   size_t min_block_size = 64,
+				   Upstream* upstream	 = &psl::default_memory_resource)
+		: base_type(alignment), m_Upstream(upstream),
+		  m_MinBlockShift((size_t)std::countr_zero(std::bit_ceil(std::max(min_block_size, sizeof(free_block_t))))) {
+		auto min_block = size_t {1} << m_MinBlockShift;
+		m_Capacity	   = std::bit_floor(std::max(capacity, min_block));
+		m_MaxOrder	   = (size_t)std::countr_zero(m_Capacity) - m_MinBlockShift;
+		PSL_EXCEPT_IF(m_MaxOrder >= max_orders, std::runtime_error, "buddy_resource capacity is too large");
+
+		auto region = m_Upstream->allocate(m_Capacity, region_alignment());
+		PSL_EXCEPT_IF(!region, std::runtime_error, "could not allocate the buddy_resource region");
+		auto meta = m_Upstream->allocate(block_count(), alignof(std::uint8_t));
+		PSL_EXCEPT_IF(!meta, std::runtime_error, "could not allocate the buddy_resource metadata");
+
+		m_Region = (std::byte*)region.data;
+		m_Meta	 = (std::uint8_t*)meta.data;
+		std::fill_n(m_Meta, block_count(), std::uint8_t {0});
+		push(0, m_MaxOrder);
+	}
+
+	~buddy_resource() {
+		m_Upstream->deallocate(m_Meta, block_count(), alignof(std::uint8_t));
+		m_Upstream->deallocate(m_Region, m_Capacity, region_alignment());
+	}
+
+	buddy_resource(buddy_resource const&)			 = delete;
+	buddy_resource(buddy_resource&&)				 = delete;
+	buddy_resource& operator=(buddy_resource const&) = delete;
+	buddy_resource& operator=(buddy_resource&&)		 = delete;
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+	size_t capacity() const noexcept { return m_Capacity; }
+	size_t min_block_size() const noexcept { return size_t {1} << m_MinBlockShift; }
+
+	/**
+	 * \brief Resizes the block at `location` to fit `count` items of `size` bytes.
+	 * \details Shrinking always happens in place. Growing happens in place when the block is the first half of each
+	 * larger block it needs to become, and the other halves are free. Otherwise a new block is returned, in which
+	 * case `location` remains allocated.
+	 */
+	alloc_results<void> reallocate(void* location, size_t size, size_t count, size_t alignment) override {
+		auto bytes = size * count;
+		if(!location || !owns(location))
+			return this->allocate(bytes, alignment);
+
+		auto align	  = std::lcm(alignment, this->alignment());
+		auto index	  = index_of(location);
+		auto order	  = (size_t)(m_Meta[index] & ~free_flag);
+		auto required = order_for(std::max(bytes, align));
+		if(required > m_MaxOrder || align > region_alignment())
+			return this->allocate(bytes, alignment);
+
+		if(required < order) {
+			while(order > required) {
+				--order;
+				push(index + (size_t {1} << order), order);
+			}
+		} else if(required > order) {
+			for(auto level = order; level < required; ++level) {
+				auto buddy = index + (size_t {1} << level);
+				if(index % (size_t {1} << (level + 1)) != 0 || m_Meta[buddy] != (free_flag | level))
+					return this->allocate(bytes, alignment);
+			}
+			for(auto level = order; level < required; ++level) remove(index + (size_t {1} << level));
+			order = required;
+		}
+		m_Meta[index] = (std::uint8_t)order;
+		return make_result((std::byte*)location, order, bytes, align);
+	}
+
+  private:
+	size_t region_alignment() const noexcept { return std::min(m_Capacity, max_region_alignment); }
+	size_t block_count() const noexcept { return m_Capacity >> m_MinBlockShift; }
+	size_t block_size(size_t order) const noexcept { return size_t {1} << (order + m_MinBlockShift); }
+	std::byte* block_at(size_t index) const noexcept { return m_Region + (index << m_MinBlockShift); }
+	size_t index_of(void* location) const noexcept {
+		return (size_t)((std::byte*)location - m_Region) >> m_MinBlockShift;
+	}
+	bool owns(void* location) const noexcept {
+		return (std::byte*)location >= m_Region && (std::byte*)location < m_Region + m_Capacity;
+	}
+
+	size_t order_for(size_t bytes) const noexcept {
+		auto blocks = (std::max<size_t>(bytes, 1) + block_size(0) - 1) >> m_MinBlockShift;
+		return (size_t)std::bit_width(blocks - 1);
+	}
+
+	void push(size_t index, size_t order) noexcept {
+		auto* block	  = new(block_at(index)) free_block_t {nullptr, m_FreeLists[order]};
+		if(block->next)
+			block->next->previous = block;
+		m_FreeLists[order] = block;
+		m_Meta[index]	   = (std::uint8_t)(free_flag | order);
+	}
+
+	void remove(size_t index) noexcept {
+		auto* block = (free_block_t*)block_at(index);
+		auto order	= m_Meta[index] & ~free_flag;
+		if(block->previous)
+			block->previous->next = block->next;
+		else
+			m_FreeLists[order] = block->next;
+		if(block->next)
+			block->next->previous = block->previous;
+		m_Meta[index] = 0;
+	}
+
+	alloc_results<void> make_result(std::byte* location, size_t order, size_t size, size_t alignment) const noexcept {
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + block_size(order);
+		result.stride = psl::align_to<size_t>(size, alignment);
+		return result;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		auto order = order_for(std::max(size, align));
+		if(order > m_MaxOrder || align > region_alignment())
+			return m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto available = order;
+		while(available <= m_MaxOrder && !m_FreeLists[available]) ++available;
+		if(available > m_MaxOrder)
+			return m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto index = index_of(m_FreeLists[available]);
+		remove(index);
+		while(available > order) {
+			--available;
+			push(index + (size_t {1} << available), available);
+		}
+		m_Meta[index] = (std::uint8_t)order;
+		return make_result(block_at(index), order, size, align);
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		if(!owns(ptr))
+			return m_Upstream->deallocate(
+			  ptr, psl::align_to<size_t>(size, this->alignment()), std::lcm(alignment, this->alignment()));
+
+		auto index = index_of(ptr);
+		auto order = (size_t)(m_Meta[index] & ~free_flag);
+		while(order < m_MaxOrder) {
+			auto buddy = index ^ (size_t {1} << order);
+			if(m_Meta[buddy] != (free_flag | order))
+				break;
+			remove(buddy);
+			m_Meta[index] = 0;
+			index		  = std::min(index, buddy);
+			++order;
+		}
+		push(index, order);
+		return true;
+	}
+
+	Upstream* m_Upstream {nullptr};
+	size_t m_MinBlockShift {6};
+	size_t m_Capacity {0};
+	size_t m_MaxOrder {0};
+	std::byte* m_Region {nullptr};
+	std::uint8_t* m_Meta {nullptr};
+	std::array<free_block_t*, max_orders> m_FreeLists {};
+};
+}	 // namespace psl
@@ -0,0 +1,191 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <utility>
+#include <vector>
+
+namespace psl {
+/**
+ * \brief Level of memory pressure reported by a `budget_resource`.
+ */
+enum class memory_pressure {
+	none = 0,
+	soft = 1,  // the usage crossed the soft watermark, caches should consider trimming.
+	hard = 2,  // the usage crossed the hard watermark, or an allocation does not fit the budget, caches should trim.
+};
+
+/**
+ * \brief Memory resource wrapper that caps the bytes allocated from its upstream resource.
+ * \details Allocations that would exceed the budget fail, after the pressure callbacks had one chance to free memory.
+ * The callbacks are also raised when an allocation makes the usage cross the soft or the hard watermark, so that
+ * caches can trim before allocations start to fail.
+ * The accounting is a single atomic counter, so allocations that do not cross a watermark never take a lock. The
+ * callbacks are invoked on the allocating thread, they are free to deallocate (and allocate) from the resource.
+ * Budgets nest by using a `budget_resource` as the upstream of another (for example a subsystem inside the global
+ * budget), an allocation then has to fit both, and raises the pressure of the budget it did not fit.
+ * \note Every allocation is charged its size rounded up to the resource's alignment, and reports no slack beyond that.
+ * \warning The upstream resource is used concurrently when the resource is, and so has to be thread-safe in that case.
+ *
+ * \tparam Upstream resource type that services the allocations.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class budget_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+										  psl::traits::basic_allocation,
+										  psl::traits::queryable_size_t> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::queryable_size_t>;
+	friend struct _priv::resource_access;
+
+  public:
+	using upstream_type		  = Upstream;
+	using pressure_callback_t = std::function<void(memory_pressure level)>;
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] budget maximum amount of bytes that can be allocated at once.
+	 * \param[in] soft_watermark usage (in bytes) that raises soft pressure.
+	 * \param[in] hard_watermark usage (in bytes) that raises hard pressure.
+	 * \param[in] upstream resource that services the allocations.
+	 */
+	budget_resource(size_t alignment,
+					size_t budget,
+					size_t soft_watermark,
+					size_t hard_watermark,
+					Upstream* upstream = &psl::default_memory_resource)
+		: base_type(alignment), m_Upstream(upstream), m_Budget(budget), m_SoftWatermark(soft_watermark),
+		  m_HardWatermark(hard_watermark) {
+		PSL_EXCEPT_IF(soft_watermark > hard_watermark || hard_watermark > budget,
+					  std::runtime_error,
+					  "budget_resource watermarks have to be ordered as soft <= hard <= budget");
+	}
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] budget maximum amount of bytes that can be allocated at once, the watermarks are set to 75% (soft)
+	 * and 90% (hard) of it.
+	 * \param[in] upstream resource that services the allocations.
+	 */
+	budget_resource(size_t alignment, size_t budget, Upstream* upstream = &psl::default_memory_resource)
+		: budget_resource(alignment, budget, budget / 4 * 3, budget / 10 * 9, upstream) {}
+
+	budget_resource(budget_resource const&)			   = delete;
+	budget_resource(budget_resource&&)				   = delete;
+	budget_resource& operator=(budget_resource const&) = delete;
+	budget_resource& operator=(budget_resource&&)	   = delete;
+
+	/**
+	 * \returns the budget in bytes.
+	 */
+	size_t size() const noexcept override { return m_Budget; }
+
+	/**
+	 * \returns the bytes that are currently allocated.
+	 */
+	size_t used() const noexcept { return m_Used.load(std::memory_order_relaxed); }
+
+	size_t available() const noexcept { return m_Budget - std::min(m_Budget, used()); }
+
+	/**
+	 * \returns the pressure level of the current usage.
+	 */
+	memory_pressure pressure() const noexcept { return level(used()); }
+
+	/**
+	 * \brief Registers a callback that is raised on pressure, see the class description.
+	 * \returns a handle that unregisters it with `remove_pressure_callback`.
+	 */
+	size_t add_pressure_callback(pressure_callback_t callback) {
+		std::lock_guard lock {m_CallbackMutex};
+		m_Callbacks.emplace_back(++m_LastCallback, std::move(callback));
+		return m_LastCallback;
+	}
+
+	void remove_pressure_callback(size_t handle) {
+		std::lock_guard lock {m_CallbackMutex};
+		std::erase_if(m_Callbacks, [handle](auto const& entry) { return entry.first == handle; });
+	}
+
+	Upstream& upstream() noexcept { return *m_Upstream; }
+
+  private:
+	memory_pressure level(size_t used) const noexcept {
+		return (used >= m_HardWatermark)   ? memory_pressure::hard
+			   : (used >= m_SoftWatermark) ? memory_pressure::soft
+										   : memory_pressure::none;
+	}
+
+	/**
+	 * \brief Adds `bytes` to the usage, unless that exceeds the budget.
+	 * \returns the usage before the reservation, or false when it did not fit.
+	 */
+	bool reserve(size_t bytes, size_t& previous) noexcept {
+		previous = m_Used.load(std::memory_order_relaxed);
+		do {
+			if(bytes > m_Budget - std::min(m_Budget, previous))
+				return false;
+		} while(!m_Used.compare_exchange_weak(previous, previous + bytes, std::memory_order_relaxed));
+		return true;
+	}
+
+	/**
+	 * \brief Invokes the callbacks, without holding the lock so that they can use the resource themselves.
+	 */
+	void raise(memory_pressure level) {
+		std::vector<std::pair<size_t, pressure_callback_t>> callbacks {};
+		{
+			std::lock_guard lock {m_CallbackMutex};
+			callbacks = m_Callbacks;
+		}
+		for(auto& [handle, callback] : callbacks) callback(level);
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto bytes = psl::align_to<size_t>(std::max<size_t>(size, 1), this->alignment());
+		size_t previous {};
+		if(!reserve(bytes, previous)) {
+			// give the caches one chance to make room before the allocation fails.
+			raise(memory_pressure::hard);
+			if(!reserve(bytes, previous))
+				return {};
+		}
+
+		auto result = m_Upstream->allocate(bytes, std::lcm(alignment, this->alignment()));
+		if(!result) {
+			m_Used.fetch_sub(bytes, std::memory_order_relaxed);
+			return {};
+		}
+		result.tail = (std::byte*)result.data + bytes;
+
+		if(auto after = level(previous + bytes); after > level(previous))
+			raise(after);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		auto bytes = psl::align_to<size_t>(std::max<size_t>(size, 1), this->alignment());
+		if(!m_Upstream->deallocate(ptr, bytes, std::lcm(alignment, this->alignment())))
+			return false;
+		m_Used.fetch_sub(bytes, std::memory_order_relaxed);
+		return true;
+	}
+
+	Upstream* m_Upstream {nullptr};
+	size_t m_Budget {0};
+	size_t m_SoftWatermark {0};
+	size_t m_HardWatermark {0};
+	std::atomic<size_t> m_Used {0};
+
+	std::mutex m_CallbackMutex {};
+	std::vector<std::pair<size_t, pressure_callback_t>> m_Callbacks {};
+	size_t m_LastCallback {0};
+};
+}	 // namespace psl
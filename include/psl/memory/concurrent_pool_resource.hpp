@@ -0,0 +1,198 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+
+namespace psl {
+/**
+ * \brief Lock-free pool of fixed size blocks.
+ * \details Blocks are handed out from chunks sourced from the upstream resource, freed blocks are kept in a lock-free
+ * (Treiber) stack. The head of the stack stores the index of the top block together with a 32bit tag that is bumped
+ * on every modification, which protects against the ABA problem without requiring a double-width CAS.
+ * Chunks grow geometrically and are never returned to the upstream before the resource is destroyed, so reading the
+ * link of a block that was concurrently popped by another thread is always safe.
+ * Allocating and deallocating are lock-free, aside from the (rare) moments a new chunk has to be sourced from the
+ * upstream resource. Requests that don't fit in a block are forwarded to the upstream resource, as are the requests
+ * that arrive once the pool cannot grow anymore (all chunks are in use, or the upstream cannot source the next one).
+ * \warning The upstream resource is used concurrently, and so has to be thread-safe.
+ *
+ * \tparam Upstream resource type to source the chunks from.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class concurrent_pool_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+	inline constexpr static size_t max_chunks {24};
+	inline constexpr static std::uint32_t empty {0};
+
+  public:
+	using upstream_type = Upstream;
+
+	/**
+	 * \param[in] alignment alignment of every block (and minimum alignment of every allocation).
+	 * \param[in] block_size size of the blocks.
+	 * \param[in] blocks_per_chunk amount of blocks in the first chunk, every following chunk doubles in size. This
+	 * gets rounded up to a power of 2.
+	 * \param[in] upstream thread-safe resource to source the chunks from.
+	 */
+	concurrent_pool_resource(size_t alignment,
+							 size_t block_size,
+							 size_t blocks_per_chunk = 256,
+							 Upstream* upstream		 = &psl::default_memory_resource) noexcept
+		: base_type(alignment), m_Upstream(upstream),
+		  m_BlockAlignment(std::lcm(alignment, alignof(std::uint32_t))),
+		  m_BlockSize(psl::align_to(std::max(block_size, sizeof(std::uint32_t)), m_BlockAlignment)),
+		  m_ChunkShift((size_t)std::countr_zero(std::bit_ceil(std::max<size_t>(blocks_per_chunk, 1)))) {}
+
+	~concurrent_pool_resource() {
+		for(size_t chunk = 0; chunk < max_chunks; ++chunk) {
+			if(auto* data = m_Chunks[chunk].load(std::memory_order_acquire); data != nullptr)
+				m_Upstream->deallocate(data, chunk_capacity(chunk) * m_BlockSize, m_BlockAlignment);
+		}
+	}
+
+	concurrent_pool_resource(concurrent_pool_resource const&)			 = delete;
+	concurrent_pool_resource(concurrent_pool_resource&&)				 = delete;
+	concurrent_pool_resource& operator=(concurrent_pool_resource const&) = delete;
+	concurrent_pool_resource& operator=(concurrent_pool_resource&&)		 = delete;
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+	size_t block_size() const noexcept { return m_BlockSize; }
+
+	/**
+	 * \returns the amount of blocks the pool can hand out without growing.
+	 */
+	size_t capacity() const noexcept {
+		size_t result {0};
+		for(size_t chunk = 0; chunk < max_chunks; ++chunk) {
+			if(m_Chunks[chunk].load(std::memory_order_relaxed) != nullptr)
+				result += chunk_capacity(chunk);
+		}
+		return result;
+	}
+
+  private:
+	size_t chunk_capacity(size_t chunk) const noexcept { return size_t {1} << (m_ChunkShift + chunk); }
+
+	/**
+	 * \brief Blocks are numbered 1..N across all chunks, chunk `n` contains the blocks in
+	 * [(2^n - 1) * first_capacity, (2^(n+1) - 1) * first_capacity) (offset by 1).
+	 */
+	std::byte* block_at(std::uint32_t index) const noexcept {
+		auto slot	= (size_t)(index - 1);
+		auto chunk	= (size_t)std::bit_width((slot >> m_ChunkShift) + 1) - 1;
+		auto offset = slot - (chunk_capacity(chunk) - (size_t {1} << m_ChunkShift));
+		return m_Chunks[chunk].load(std::memory_order_acquire) + offset * m_BlockSize;
+	}
+
+	std::uint32_t index_of(std::byte* location) const noexcept {
+		for(size_t chunk = 0; chunk < max_chunks; ++chunk) {
+			auto* data = m_Chunks[chunk].load(std::memory_order_acquire);
+			if(data && location >= data && location < data + chunk_capacity(chunk) * m_BlockSize) {
+				auto first = chunk_capacity(chunk) - (size_t {1} << m_ChunkShift);
+				return (std::uint32_t)(first + (size_t)(location - data) / m_BlockSize + 1);
+			}
+		}
+		return empty;
+	}
+
+	static std::atomic_ref<std::uint32_t> link_of(std::byte* block) noexcept {
+		return std::atomic_ref<std::uint32_t> {*(std::uint32_t*)block};
+	}
+
+	bool ensure_chunk(size_t chunk) {
+		if(m_Chunks[chunk].load(std::memory_order_acquire) != nullptr)
+			return true;
+
+		auto res = m_Upstream->allocate(chunk_capacity(chunk) * m_BlockSize, m_BlockAlignment);
+		if(!res)
+			return false;
+		std::byte* expected {nullptr};
+		if(!m_Chunks[chunk].compare_exchange_strong(
+			 expected, (std::byte*)res.data, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			m_Upstream->deallocate(res.data, chunk_capacity(chunk) * m_BlockSize, m_BlockAlignment);
+		}
+		return true;
+	}
+
+	std::uint32_t pop() noexcept {
+		auto head = m_Head.load(std::memory_order_acquire);
+		while((std::uint32_t)head != empty) {
+			auto* block = block_at((std::uint32_t)head);
+			auto next	= link_of(block).load(std::memory_order_relaxed);
+			auto tag	= (head >> 32) + 1;
+			if(m_Head.compare_exchange_weak(
+				 head, (tag << 32) | next, std::memory_order_acquire, std::memory_order_acquire))
+				return (std::uint32_t)head;
+		}
+		return empty;
+	}
+
+	void push(std::uint32_t index, std::byte* block) noexcept {
+		auto head = m_Head.load(std::memory_order_relaxed);
+		do {
+			link_of(block).store((std::uint32_t)head, std::memory_order_relaxed);
+		} while(!m_Head.compare_exchange_weak(head,
+											  (((head >> 32) + 1) << 32) | index,
+											  std::memory_order_release,
+											  std::memory_order_relaxed));
+	}
+
+	alloc_results<void> allocate_upstream(size_t size, size_t alignment) {
+		return m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()),
+									std::lcm(alignment, this->alignment()));
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		if(size > m_BlockSize || m_BlockAlignment % alignment != 0)
+			return allocate_upstream(size, alignment);
+
+		auto index = pop();
+		if(index == empty) {
+			// carve a block that was never handed out before, the slot is only claimed once its chunk exists, so that
+			// slots aren't lost when the upstream fails to source the chunk.
+			auto slot = m_Next.load(std::memory_order_relaxed);
+			do {
+				auto chunk = (size_t)std::bit_width((slot >> m_ChunkShift) + 1) - 1;
+				// the deallocation finds the block outside of the chunks, and forwards it to the upstream as well.
+				if(chunk >= max_chunks || slot >= std::numeric_limits<std::uint32_t>::max() || !ensure_chunk(chunk))
+					return allocate_upstream(size, alignment);
+			} while(!m_Next.compare_exchange_weak(slot, slot + 1, std::memory_order_relaxed));
+			index = (std::uint32_t)(slot + 1);
+		}
+
+		auto* location = block_at(index);
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + m_BlockSize;
+		result.stride = m_BlockSize;
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		auto index = index_of((std::byte*)ptr);
+		if(index == empty)
+			return m_Upstream->deallocate(
+			  ptr, psl::align_to<size_t>(size, this->alignment()), std::lcm(alignment, this->alignment()));
+		push(index, (std::byte*)ptr);
+		return true;
+	}
+
+	Upstream* m_Upstream {nullptr};
+	size_t m_BlockAlignment {1};
+	size_t m_BlockSize {0};
+	size_t m_ChunkShift {0};
+	std::array<std::atomic<std::byte*>, max_chunks> m_Chunks {};
+	alignas(64) std::atomic<std::uint64_t> m_Head {0};
+	alignas(64) std::atomic<size_t> m_Next {0};
+};
+}	 // namespace psl
@@ -0,0 +1,177 @@
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <psl/allocator.hpp>
+#include <span>
+#include <vector>
+
+namespace psl {
+/**
+ * \brief Tracks the allocations made from a memory resource, and incrementally compacts them on request.
+ * \details Meant for bookkeeping-style resources (such as `offset_resource` or `tlsf_resource<false>`) that
+ * sub-allocate a heap which fragments over time. Every allocation is made through the defragmenter, which hands out a
+ * handle that stays valid (and reflects the current location of the allocation) until it is deallocated.
+ *
+ * Calling `step()` walks the allocations from the highest address to the lowest, and tries to move every one of them
+ * into a free range of the resource at a lower address. A step stops once its move plan would exceed the given byte
+ * budget, and the next step continues where the previous one stopped, so a heap can be compacted over several frames.
+ * The plan of a step is handed to the relocation callback (which is expected to copy, or schedule a copy of, the
+ * contents), after which the source ranges are released and the handles are updated.
+ * \note None of the destinations of a plan overlap any of its sources, so its moves can be executed in any order. The
+ * source ranges are released as soon as the callback returns, when the copies are deferred (i.e. on a GPU queue) the
+ * caller has to make sure these ranges aren't reused before the copies have completed.
+ * \note The defragmenter is not synchronized.
+ * \tparam Resource the memory resource that backs the allocations, this has to outlive the defragmenter.
+ */
+template <IsMemoryResource Resource>
+class defragmenter {
+  public:
+	/**
+	 * \brief Allocation that is tracked by the defragmenter.
+	 */
+	struct allocation_t {
+		void* data;
+		size_t size;
+		size_t alignment;
+		void* user_data;	// caller provided value, to find the owner of the allocation during a relocation.
+	};
+
+	/**
+	 * \brief Stable reference to an allocation, the `data` it points to is updated when the allocation moves.
+	 */
+	using handle_t = allocation_t const*;
+
+	/**
+	 * \brief Single move of a step's plan, `allocation` already refers to the allocation, but still points to `source`.
+	 */
+	struct relocation_t {
+		void* source;
+		void* destination;
+		size_t size;
+		handle_t allocation;
+	};
+
+	struct step_result_t {
+		size_t moves;
+		size_t bytes;
+		bool completed;	   // the step finished a pass over all allocations, the next step starts a new pass.
+	};
+
+	explicit defragmenter(Resource& resource) : m_Resource(&resource) {}
+	~defragmenter() {
+		for(auto& [address, allocation] : m_Allocations)
+			m_Resource->deallocate(allocation.data, allocation.size, allocation.alignment);
+	}
+
+	defragmenter(defragmenter const&)			 = delete;
+	defragmenter(defragmenter&&)				 = delete;
+	defragmenter& operator=(defragmenter const&) = delete;
+	defragmenter& operator=(defragmenter&&)		 = delete;
+
+	/**
+	 * \returns a handle to the new allocation, or `nullptr` when the resource could not satisfy it.
+	 */
+	handle_t allocate(size_t size, size_t alignment, void* user_data = nullptr) {
+		auto result = m_Resource->allocate(size, alignment);
+		if(!result)
+			return nullptr;
+		auto [it, inserted] = m_Allocations.emplace((std::uintptr_t)result.data,
+													allocation_t {result.data, size, alignment, user_data});
+		m_LiveBytes += size;
+		return &it->second;
+	}
+
+	/**
+	 * \returns false when the handle is not owned by this defragmenter.
+	 */
+	bool deallocate(handle_t handle) {
+		if(!handle)
+			return true;
+		auto it = m_Allocations.find((std::uintptr_t)handle->data);
+		if(it == m_Allocations.end() || &it->second != handle)
+			return false;
+		m_Resource->deallocate(handle->data, handle->size, handle->alignment);
+		m_LiveBytes -= handle->size;
+		m_Allocations.erase(it);
+		return true;
+	}
+
+	/**
+	 * \brief Plans and executes the next part of the compaction.
+	 * \details Allocations larger than `max_bytes` are never moved.
+	 * \param[in] max_bytes upper bound of the sum of the sizes of the planned moves.
+	 * \param[in] relocate invoked with the plan as a `std::span<relocation_t const>`, only when it contains moves.
+	 */
+	template <typename Fn>
+	requires std::invocable<Fn&, std::span<relocation_t const>>
+	step_result_t step(size_t max_bytes, Fn&& relocate) {
+		step_result_t result {0, 0, false};
+		m_Plan.clear();
+
+		auto it = m_Allocations.upper_bound(m_Cursor);
+		while(true) {
+			if(it == m_Allocations.begin()) {
+				result.completed = true;
+				m_Cursor		 = std::numeric_limits<std::uintptr_t>::max();
+				break;
+			}
+			auto candidate	 = std::prev(it);
+			auto& allocation = candidate->second;
+			if(allocation.size <= max_bytes && result.bytes + allocation.size > max_bytes) {
+				m_Cursor = candidate->first;
+				break;
+			}
+			it = candidate;
+			if(allocation.size > max_bytes)
+				continue;
+
+			// the sources are only released once the plan is complete, so a destination never overlaps a source.
+			auto destination = m_Resource->allocate(allocation.size, allocation.alignment);
+			if(!destination)
+				continue;
+			if((std::uintptr_t)destination.data >= candidate->first) {
+				m_Resource->deallocate(destination.data, allocation.size, allocation.alignment);
+				continue;
+			}
+			m_Plan.emplace_back(allocation.data, destination.data, allocation.size, &allocation);
+			result.bytes += allocation.size;
+		}
+
+		result.moves = m_Plan.size();
+		if(m_Plan.empty())
+			return result;
+		relocate(std::span<relocation_t const> {m_Plan});
+
+		for(auto const& relocation : m_Plan) {
+			// re-keying the node keeps the allocation (and so the handle) at the same address.
+			auto node = m_Allocations.extract((std::uintptr_t)relocation.source);
+			m_Resource->deallocate(relocation.source, relocation.size, node.mapped().alignment);
+			node.key()		   = (std::uintptr_t)relocation.destination;
+			node.mapped().data = relocation.destination;
+			m_Allocations.insert(std::move(node));
+		}
+		return result;
+	}
+
+	/**
+	 * \returns the amount of live allocations.
+	 */
+	size_t size() const noexcept { return m_Allocations.size(); }
+
+	/**
+	 * \returns the sum of the sizes of the live allocations.
+	 */
+	size_t live_bytes() const noexcept { return m_LiveBytes; }
+
+	Resource& resource() const noexcept { return *m_Resource; }
+
+  private:
+	Resource* m_Resource {nullptr};
+	std::map<std::uintptr_t, allocation_t> m_Allocations {};
+	std::vector<relocation_t> m_Plan {};
+	std::uintptr_t m_Cursor {std::numeric_limits<std::uintptr_t>::max()};	 // every allocation above this was visited.
+	size_t m_LiveBytes {0};
+};
+}	 // namespace psl
@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <span>
+#include <vector>
+
+namespace psl {
+/**
+ * \brief Memory resource that records which byte ranges of its allocations were written, so that a flush
+ * synchronized resource only has to flush those.
+ * \details Writes are reported with `mark_dirty`, the ranges are rounded out to the flush granularity and merged per
+ * allocation with the ranges they overlap or touch (or that are at most `merge_gap` bytes away, trading a few clean
+ * bytes for a call). `flush` then hands every remaining range to the flush hook once, and forgets them.
+ * Deallocating a block drops its pending ranges.
+ *
+ * \tparam Upstream resource that holds the memory.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class dirty_tracking_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+										  psl::traits::basic_allocation,
+										  psl::traits::host_writability_t<psl::traits::syncronization::flush>> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::host_writability_t<psl::traits::syncronization::flush>>;
+	friend struct _priv::resource_access;
+
+	struct allocation_t {
+		size_t size {0};
+		std::map<size_t, size_t> ranges {};	   // start offset to end offset of the dirty ranges.
+	};
+
+  public:
+	using upstream_type = Upstream;
+
+	/**
+	 * \brief Flushes the `size` bytes at `location` to the memory's other side.
+	 */
+	using flush_hook_t = std::function<void(void* location, size_t size)>;
+
+	struct flush_stats_t {
+		size_t calls {0};
+		size_t bytes {0};
+	};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] hook invoked for every range on `flush`.
+	 * \param[in] granularity the ranges are rounded out to multiples of this (relative to the start of their
+	 * allocation), for example the non-coherent atom size of a device.
+	 * \param[in] merge_gap ranges that are at most this amount of bytes apart are flushed as one.
+	 * \param[in] upstream resource that holds the memory.
+	 */
+	dirty_tracking_resource(size_t alignment,
+							flush_hook_t hook,
+							size_t granularity = 1,
+							size_t merge_gap   = 0,
+							Upstream* upstream = &psl::default_memory_resource)
+		: base_type(alignment), m_Upstream(upstream), m_Hook(std::move(hook)), m_Granularity(granularity),
+		  m_MergeGap(merge_gap) {
+		PSL_EXCEPT_IF(granularity == 0, std::runtime_error, "dirty_tracking_resource granularity cannot be 0");
+	}
+
+	dirty_tracking_resource(dirty_tracking_resource const&)			   = delete;
+	dirty_tracking_resource(dirty_tracking_resource&&)				   = delete;
+	dirty_tracking_resource& operator=(dirty_tracking_resource const&) = delete;
+	dirty_tracking_resource& operator=(dirty_tracking_resource&&)	   = delete;
+
+	/**
+	 * \brief Records that the `size` bytes at `location` were written.
+	 * \throws std::out_of_range when the range does not start in an allocation of the resource, the range is clipped
+	 * to the end of the allocation.
+	 */
+	void mark_dirty(void const* location, size_t size) {
+		if(size == 0)
+			return;
+		auto it = m_Allocations.upper_bound((std::uintptr_t)location);
+		PSL_EXCEPT_IF(it == m_Allocations.begin(), std::out_of_range, "the range is not part of an allocation");
+		--it;
+		auto offset = (std::uintptr_t)location - it->first;
+		PSL_EXCEPT_IF(offset >= it->second.size, std::out_of_range, "the range is not part of an allocation");
+
+		auto& allocation = it->second;
+		auto begin		 = offset - offset % m_Granularity;
+		auto end		 = std::min(psl::align_to<size_t>(offset + size, m_Granularity), allocation.size);
+		if(allocation.ranges.empty())
+			m_Dirty.emplace_back(it->first);
+		insert(allocation.ranges, begin, end);
+	}
+
+	template <typename T>
+	void mark_dirty(std::span<T> range) {
+		mark_dirty(range.data(), range.size_bytes());
+	}
+
+	/**
+	 * \brief Invokes the flush hook once for every dirty range, and clears them.
+	 */
+	flush_stats_t flush() {
+		flush_stats_t stats {};
+		for(auto address : m_Dirty) {
+			auto& allocation = m_Allocations.at(address);
+			for(auto [begin, end] : allocation.ranges) {
+				m_Hook((void*)(address + begin), end - begin);
+				++stats.calls;
+				stats.bytes += end - begin;
+			}
+			allocation.ranges.clear();
+		}
+		m_Dirty.clear();
+		return stats;
+	}
+
+	/**
+	 * \returns the amount of bytes the next `flush` hands to the hook.
+	 */
+	size_t dirty_bytes() const noexcept {
+		size_t bytes {0};
+		for(auto address : m_Dirty)
+			for(auto [begin, end] : m_Allocations.find(address)->second.ranges) bytes += end - begin;
+		return bytes;
+	}
+
+	/**
+	 * \returns the amount of calls the next `flush` makes to the hook.
+	 */
+	size_t dirty_ranges() const noexcept {
+		size_t count {0};
+		for(auto address : m_Dirty) count += m_Allocations.find(address)->second.ranges.size();
+		return count;
+	}
+
+	Upstream& upstream() noexcept { return *m_Upstream; }
+
+  private:
+	/**
+	 * \brief Adds `[begin, end)` to the ranges, merged with every range it overlaps, touches, or is close to.
+	 */
+	void insert(std::map<size_t, size_t>& ranges, size_t begin, size_t end) {
+		auto it = ranges.upper_bound(begin);
+		if(it != ranges.begin() && std::prev(it)->second + m_MergeGap >= begin)
+			--it;
+		while(it != ranges.end() && it->first <= end + m_MergeGap) {
+			begin = std::min(begin, it->first);
+			end	  = std::max(end, it->second);
+			it	  = ranges.erase(it);
+		}
+		ranges.emplace_hint(it, begin, end);
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto result = m_Upstream->allocate(size, std::lcm(alignment, this->alignment()));
+		if(result)
+			m_Allocations.emplace((std::uintptr_t)result.data,
+								  allocation_t {(size_t)(result.tail - (std::byte*)result.data)});
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		if(auto it = m_Allocations.find((std::uintptr_t)ptr); it != m_Allocations.end()) {
+			if(!it->second.ranges.empty())
+				m_Dirty.erase(std::find(m_Dirty.begin(), m_Dirty.end(), it->first));
+			m_Allocations.erase(it);
+		}
+		return m_Upstream->deallocate(ptr, size, std::lcm(alignment, this->alignment()));
+	}
+
+	Upstream* m_Upstream {nullptr};
+	flush_hook_t m_Hook {};
+	size_t m_Granularity {1};
+	size_t m_MergeGap {0};
+	std::map<std::uintptr_t, allocation_t> m_Allocations {};
+	std::vector<std::uintptr_t> m_Dirty {};	   // allocations that have dirty ranges, in the order they were dirtied.
+};
+}	 // namespace psl
@@ -0,0 +1,89 @@
+#pragma once
+#include <numeric>
+#include <psl/allocator.hpp>
+#include <psl/details/combined_traits.hpp>
+#include <tuple>
+
+namespace psl {
+/**
+ * \brief Serves allocations from `Primary`, and from `Secondary` when the primary resource runs out.
+ * \details Both resources are owned by the fallback resource. A deallocation is handed to the primary resource when
+ * it `owns()` the block, resources without an `owns()` member are expected to reject the blocks they did not
+ * allocate by returning false from `deallocate` (as the region based resources, such as `tlsf_resource`, do), the
+ * block is then handed to the secondary resource.
+ * The resource is only shareable (or size queryable) when both resources are.
+ * \note Only failed allocations (an invalid `alloc_results`) fall back, exceptions from the primary resource are not
+ * caught.
+ *
+ * \tparam Primary resource that is tried first.
+ * \tparam Secondary resource that serves the allocations the primary resource could not.
+ */
+template <IsMemoryResource Primary, IsMemoryResource Secondary>
+class fallback_resource : public _priv::combined_resource_t<fallback_resource<Primary, Secondary>, Primary, Secondary> {
+	using base_type = _priv::combined_resource_t<fallback_resource<Primary, Secondary>, Primary, Secondary>;
+	friend struct _priv::resource_access;
+	friend base_type;
+
+  public:
+	using primary_type	 = Primary;
+	using secondary_type = Secondary;
+
+	/**
+	 * \brief Constructs both resources from just the alignment.
+	 */
+	fallback_resource(size_t alignment) : base_type(alignment), m_Primary(alignment), m_Secondary(alignment) {}
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] primary constructor arguments of the primary resource.
+	 * \param[in] secondary constructor arguments of the secondary resource.
+	 */
+	template <typename... PrimaryArgs, typename... SecondaryArgs>
+	fallback_resource(size_t alignment, std::tuple<PrimaryArgs...> primary, std::tuple<SecondaryArgs...> secondary)
+		: base_type(alignment), m_Primary(std::make_from_tuple<Primary>(std::move(primary))),
+		  m_Secondary(std::make_from_tuple<Secondary>(std::move(secondary))) {}
+
+	fallback_resource(fallback_resource const&)			   = delete;
+	fallback_resource(fallback_resource&&)				   = delete;
+	fallback_resource& operator=(fallback_resource const&) = delete;
+	fallback_resource& operator=(fallback_resource&&)	   = delete;
+
+	Primary& primary() noexcept { return m_Primary; }
+	Primary const& primary() const noexcept { return m_Primary; }
+	Secondary& secondary() noexcept { return m_Secondary; }
+	Secondary const& secondary() const noexcept { return m_Secondary; }
+
+  private:
+	size_t combined_size() const noexcept { return m_Primary.size() + m_Secondary.size(); }
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		if(auto result = m_Primary.allocate(size, align))
+			return result;
+		return m_Secondary.allocate(size, align);
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		auto align = std::lcm(alignment, this->alignment());
+		if constexpr(requires { m_Primary.owns(ptr); }) {
+			if(m_Primary.owns(ptr))
+				return m_Primary.deallocate(ptr, size, align);
+		} else if(m_Primary.deallocate(ptr, size, align))
+			return true;
+		return m_Secondary.deallocate(ptr, size, align);
+	}
+
+	size_t do_allocate_batch(size_t size, size_t alignment, size_t count, void** items) override {
+		auto align	   = std::lcm(alignment, this->alignment());
+		auto allocated = m_Primary.allocate_batch(size, align, count, items);
+		if(allocated == count)
+			return allocated;
+		return allocated + m_Secondary.allocate_batch(size, align, count - allocated, items + allocated);
+	}
+
+	Primary m_Primary;
+	Secondary m_Secondary;
+};
+}	 // namespace psl
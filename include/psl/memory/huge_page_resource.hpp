@@ -0,0 +1,136 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/virtual_memory.hpp>
+#include <vector>
+
+namespace psl {
+/**
+ * \brief Memory resource that backs large allocations with huge pages, to reduce TLB pressure when traversing them.
+ * \details Allocations of at least `threshold` bytes are mapped directly from the OS, rounded up to and aligned on the
+ * huge page size (2 MiB on most platforms). Explicit huge pages (`MAP_HUGETLB`) are used when the system has them
+ * available, otherwise transparent huge pages are requested on the range (`madvise(MADV_HUGEPAGE)`). When neither is
+ * possible the range is backed by normal pages. Smaller allocations are forwarded to the upstream resource.
+ * `advised_bytes` reports how many of the mapped bytes were mapped as, or advised to be, huge pages.
+ * \note When transparent huge pages are used, the OS is only asked to back the range with huge pages. Whether it
+ * does depends on the system configuration and memory fragmentation, and is not tracked by the resource (on Linux
+ * `AnonHugePages` in `/proc/self/smaps` shows how much of the mapping actually is).
+ *
+ * \tparam Upstream resource type that services the allocations below the threshold.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class huge_page_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+	struct mapping_t {
+		void* address;
+		size_t size;
+		bool huge;
+	};
+
+  public:
+	using upstream_type = Upstream;
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] threshold allocations of this size (in bytes) or larger are backed by huge pages, this defaults to
+	 * half a huge page.
+	 * \param[in] upstream resource to forward the smaller allocations to.
+	 */
+	huge_page_resource(size_t alignment,
+					   size_t threshold	  = _priv::virtual_memory::huge_page_size() / 2,
+					   Upstream* upstream = &psl::default_memory_resource) noexcept
+		: base_type(alignment), m_Upstream(upstream), m_Threshold(std::max<size_t>(threshold, 1)) {}
+
+	~huge_page_resource() {
+		for(auto const& mapping : m_Mappings) _priv::virtual_memory::release(mapping.address, mapping.size);
+	}
+
+	huge_page_resource(huge_page_resource const&)			 = delete;
+	huge_page_resource(huge_page_resource&&)				 = delete;
+	huge_page_resource& operator=(huge_page_resource const&) = delete;
+	huge_page_resource& operator=(huge_page_resource&&)		 = delete;
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+	size_t threshold() const noexcept { return m_Threshold; }
+
+	/**
+	 * \returns the amount of bytes currently mapped by the resource (i.e. the allocations above the threshold).
+	 */
+	size_t mapped_bytes() const noexcept { return m_MappedBytes.load(std::memory_order_relaxed); }
+
+	/**
+	 * \returns the amount of the mapped bytes that were mapped as explicit huge pages, or that the OS accepted the
+	 * advice to back with transparent huge pages for.
+	 */
+	size_t advised_bytes() const noexcept { return m_AdvisedBytes.load(std::memory_order_relaxed); }
+
+  private:
+	size_t mapped_size(size_t size) const noexcept {
+		return psl::align_to(std::max<size_t>(size, 1), _priv::virtual_memory::huge_page_size());
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		if(size < m_Threshold || _priv::virtual_memory::huge_page_size() % align != 0)
+			return m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto bytes = mapped_size(size);
+		bool huge {false};
+		auto* location = (std::byte*)_priv::virtual_memory::map_huge(bytes, huge);
+		if(!location)
+			return m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()), align);
+
+		{
+			std::lock_guard guard {m_Lock};
+			m_Mappings.emplace_back(location, bytes, huge);
+		}
+		m_MappedBytes.fetch_add(bytes, std::memory_order_relaxed);
+		if(huge)
+			m_AdvisedBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + bytes;
+		result.stride = psl::align_to<size_t>(size, align);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(ptr && size >= m_Threshold && (std::uintptr_t)ptr % _priv::virtual_memory::huge_page_size() == 0) {
+			// the mapping can be absent when mapping failed, and the allocation was serviced by the upstream instead.
+			std::unique_lock guard {m_Lock};
+			if(auto it = std::find_if(m_Mappings.begin(),
+									  m_Mappings.end(),
+									  [ptr](auto const& mapping) { return mapping.address == ptr; });
+			   it != m_Mappings.end()) {
+				auto mapping = *it;
+				*it			 = m_Mappings.back();
+				m_Mappings.pop_back();
+				guard.unlock();
+
+				m_MappedBytes.fetch_sub(mapping.size, std::memory_order_relaxed);
+				if(mapping.huge)
+					m_AdvisedBytes.fetch_sub(mapping.size, std::memory_order_relaxed);
+				return _priv::virtual_memory::release(mapping.address, mapping.size);
+			}
+		}
+		return m_Upstream->deallocate(
+		  ptr, psl::align_to<size_t>(size, this->alignment()), std::lcm(alignment, this->alignment()));
+	}
+
+	Upstream* m_Upstream {nullptr};
+	size_t m_Threshold {0};
+	std::atomic<size_t> m_MappedBytes {0};
+	std::atomic<size_t> m_AdvisedBytes {0};
+	std::mutex m_Lock {};
+	std::vector<mapping_t> m_Mappings {};	 // live mappings, only allocations above the threshold end up here.
+};
+}	 // namespace psl
@@ -0,0 +1,369 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/mapped_file.hpp>
+#include <psl/details/virtual_memory.hpp>
+#include <span>
+#include <type_traits>
+
+namespace psl {
+/**
+ * \brief Header at the start of a file managed by a `mapped_file_resource`.
+ * \details All bookkeeping in the file is stored as offsets from the start of the file, so that the file can be
+ * mapped at any address.
+ */
+struct mapped_file_header_t {
+	inline constexpr static char magic_value[8] {'P', 'S', 'L', 'M', 'F', 'I', 'L', 'E'};
+	inline constexpr static std::uint32_t current_version {1};
+	inline constexpr static std::uint32_t byte_order_value {0x01020304};
+	inline constexpr static size_t root_count {16};
+
+	/**
+	 * \brief Named entry point into the file, see `mapped_file_resource::set_root`.
+	 */
+	struct root_t {
+		std::uint64_t offset;	 // 0 when the root is not set.
+		std::uint64_t count;
+		std::uint32_t element_size;
+		std::uint32_t element_alignment;
+		std::uint64_t released;	 // 1 once the allocation was deallocated, it is then freed along with the root.
+	};
+
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t header_size;
+	std::uint32_t byte_order;
+	std::uint32_t pointer_size;
+	std::uint64_t layout;	  // user defined tag, checked when the file is opened.
+	std::uint64_t capacity;
+	std::uint64_t top;		  // offset of the first byte that was never allocated.
+	std::uint64_t free_list;  // offset of the first free block, free blocks are ordered by their offset.
+	std::uint64_t reserved;
+	root_t roots[root_count];
+};
+static_assert(std::is_trivially_copyable_v<mapped_file_header_t> && sizeof(mapped_file_header_t) % 16 == 0);
+
+/**
+ * \brief Memory resource that allocates out of a memory mapped file, so that its allocations persist.
+ * \details The bookkeeping lives in the file itself, and only uses offsets, so reopening the file (in another process,
+ * or at another address) gives access to everything that was allocated before without any parsing or copying.
+ * Allocations are served first-fit from a list of free blocks, and otherwise from the never allocated space at the
+ * end. Freed blocks are merged with their free neighbours.
+ *
+ * Allocations are found again through the roots stored in the header, `set_root` records an allocation (such as the
+ * storage of a `psl::array`) in one of the slots, and `root` returns a view of it after the file is reopened. A rooted
+ * allocation is pinned, deallocating it is deferred until the root is released, so the container that filled it can be
+ * destroyed without losing the contents. The block is freed once both the root and the container released it, in
+ * whichever order that happens.
+ * Only trivially copyable types without pointers are meaningful to persist, as the file can be mapped at a different
+ * address every time.
+ * \note The capacity of the file is fixed when it is created. The resource is not synchronized, and a file should
+ * only be opened by one resource at a time.
+ */
+class mapped_file_resource : public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+																 psl::traits::basic_allocation,
+																 psl::traits::queryable_size_t> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::queryable_size_t>;
+	friend struct _priv::resource_access;
+
+	/**
+	 * \brief Precedes every block, `next` links the free blocks, and is the padding before the header of an allocated
+	 * block (which is at its start when it needs no extra alignment).
+	 */
+	struct block_t {
+		std::uint64_t size;
+		std::uint64_t next;
+	};
+	inline constexpr static size_t min_block_size {sizeof(block_t) * 2};
+
+  public:
+	enum class open_mode {
+		open = 0,			 // open an existing file, fails when it does not exist.
+		create = 1,			 // create a new file, replacing any existing file.
+		open_or_create = 2,	 // open the file when it exists, create it otherwise.
+	};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation, cannot be larger than the page size.
+	 * \param[in] path location of the file.
+	 * \param[in] mode whether to open an existing file or create a new one.
+	 * \param[in] capacity size of the file when it is created, ignored when an existing file is opened.
+	 * \param[in] layout user defined tag (for example a hash of the persisted types) stored in a new file, an existing
+	 * file has to have the same tag.
+	 * \throws std::runtime_error when the file cannot be mapped, or when an existing file was not written by this
+	 * version of the resource, on an incompatible platform, or with a different layout.
+	 */
+	mapped_file_resource(
+	  size_t alignment, char const* path, open_mode mode, size_t capacity = 0, std::uint64_t layout = 0)
+		: base_type(alignment) {
+		PSL_EXCEPT_IF(_priv::virtual_memory::page_size() % alignment != 0,
+					  std::runtime_error,
+					  "mapped_file_resource alignment cannot exceed the page size");
+		if(mode == open_mode::open_or_create)
+			mode = _priv::mapped_file::exists(path) ? open_mode::open : open_mode::create;
+
+		if(mode == open_mode::create) {
+			PSL_EXCEPT_IF(capacity < sizeof(mapped_file_header_t) + min_block_size,
+						  std::runtime_error,
+						  "mapped_file_resource capacity is too small");
+			PSL_EXCEPT_IF(!_priv::mapped_file::map(m_Mapping, path, capacity),
+						  std::runtime_error,
+						  "could not create the mapped file");
+			m_Base = (std::byte*)m_Mapping.address;
+			mapped_file_header_t header {};
+			std::memcpy(header.magic, mapped_file_header_t::magic_value, sizeof(header.magic));
+			header.version		= mapped_file_header_t::current_version;
+			header.header_size	= sizeof(mapped_file_header_t);
+			header.byte_order	= mapped_file_header_t::byte_order_value;
+			header.pointer_size = sizeof(void*);
+			header.layout		= layout;
+			header.capacity		= capacity;
+			header.top			= sizeof(mapped_file_header_t);
+			std::memcpy(m_Base, &header, sizeof(header));
+		} else {
+			PSL_EXCEPT_IF(
+			  !_priv::mapped_file::map(m_Mapping, path, 0), std::runtime_error, "could not open the mapped file");
+			m_Base = (std::byte*)m_Mapping.address;
+			if(auto* error = validate(layout)) {
+				_priv::mapped_file::unmap(m_Mapping);
+				PSL_EXCEPT(std::runtime_error, error);
+			}
+		}
+	}
+
+	~mapped_file_resource() { _priv::mapped_file::unmap(m_Mapping); }
+
+	mapped_file_resource(mapped_file_resource const&)			 = delete;
+	mapped_file_resource(mapped_file_resource&&)				 = delete;
+	mapped_file_resource& operator=(mapped_file_resource const&) = delete;
+	mapped_file_resource& operator=(mapped_file_resource&&)		 = delete;
+
+	/**
+	 * \returns the size of the file in bytes.
+	 */
+	size_t size() const noexcept override { return m_Mapping.size; }
+
+	mapped_file_header_t const& header() const noexcept { return *(mapped_file_header_t const*)m_Base; }
+
+	/**
+	 * \returns the offset of `location` from the start of the file.
+	 */
+	size_t offset(void const* location) const noexcept { return (size_t)((std::byte const*)location - m_Base); }
+
+	/**
+	 * \brief Writes all modifications back to the file, and waits for them to complete.
+	 */
+	bool flush() noexcept { return _priv::mapped_file::flush(m_Mapping, m_Base, m_Mapping.size); }
+
+	/**
+	 * \brief Writes the modifications of the given range (and the header) back to the file.
+	 */
+	bool flush(void const* location, size_t size) noexcept {
+		return _priv::mapped_file::flush(m_Mapping, m_Base, sizeof(mapped_file_header_t)) &&
+			   _priv::mapped_file::flush(m_Mapping, (void*)location, size);
+	}
+
+	/**
+	 * \brief Records the `count` elements at `data` in the root `slot`, and pins their allocation.
+	 * \details `data` has to be the start of an allocation of this resource. The allocation that was previously
+	 * recorded in the slot (unless it is the same allocation) is released as by `release_root`.
+	 */
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	void set_root(size_t slot, T const* data, size_t count) {
+		PSL_EXCEPT_IF(slot >= mapped_file_header_t::root_count, std::out_of_range, "root slot out of range");
+		PSL_EXCEPT_IF(!owns(data), std::runtime_error, "the root has to be an allocation of the resource");
+		auto& root	  = header_ref().roots[slot];
+		auto previous = root;
+		auto released = previous.offset == offset(data) ? previous.released : 0;
+		root		  = {offset(data), count, (std::uint32_t)sizeof(T), (std::uint32_t)alignof(T), released};
+		if(previous.offset != 0 && previous.offset != offset(data) && previous.released != 0)
+			settle(previous.offset);
+	}
+
+	/**
+	 * \returns a view of the elements recorded in the root `slot`, this is empty when the slot is not set.
+	 * \throws std::runtime_error when the root was recorded with a different element type size or alignment.
+	 */
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	std::span<T> root(size_t slot) const {
+		PSL_EXCEPT_IF(slot >= mapped_file_header_t::root_count, std::out_of_range, "root slot out of range");
+		auto const& root = header().roots[slot];
+		if(root.offset == 0)
+			return {};
+		PSL_EXCEPT_IF(root.element_size != sizeof(T) || root.element_alignment != alignof(T),
+					  std::runtime_error,
+					  "the root was recorded with a different element type");
+		return {(T*)(m_Base + root.offset), (size_t)root.count};
+	}
+
+	/**
+	 * \brief Clears the root `slot`, the allocation it referred to is deallocated when its container already
+	 * deallocated it.
+	 */
+	void release_root(size_t slot) {
+		PSL_EXCEPT_IF(slot >= mapped_file_header_t::root_count, std::out_of_range, "root slot out of range");
+		auto& root	  = header_ref().roots[slot];
+		auto previous = root;
+		root		  = {};
+		if(previous.offset != 0 && previous.released != 0)
+			settle(previous.offset);
+	}
+
+  private:
+	mapped_file_header_t& header_ref() noexcept { return *(mapped_file_header_t*)m_Base; }
+	block_t& block_at(std::uint64_t offset) noexcept { return *(block_t*)(m_Base + offset); }
+
+	char const* validate(std::uint64_t layout) const noexcept {
+		if(m_Mapping.size < sizeof(mapped_file_header_t))
+			return "the file is not a psl mapped file";
+		auto const& header = this->header();
+		if(std::memcmp(header.magic, mapped_file_header_t::magic_value, sizeof(header.magic)) != 0)
+			return "the file is not a psl mapped file";
+		if(header.version != mapped_file_header_t::current_version ||
+		   header.header_size != sizeof(mapped_file_header_t))
+			return "the mapped file was written by an incompatible version";
+		if(header.byte_order != mapped_file_header_t::byte_order_value || header.pointer_size != sizeof(void*))
+			return "the mapped file was written on an incompatible platform";
+		if(header.layout != layout)
+			return "the mapped file has a different layout";
+		if(header.capacity != m_Mapping.size || header.top > header.capacity)
+			return "the mapped file is corrupt";
+		return nullptr;
+	}
+
+	bool owns(void const* location) const noexcept {
+		return (std::byte const*)location >= m_Base + sizeof(mapped_file_header_t) + sizeof(block_t) &&
+			   (std::byte const*)location < m_Base + header().top;
+	}
+
+	alloc_results<void> make_result(std::byte* location, std::byte* end, size_t size, size_t alignment) {
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = end;
+		result.stride = psl::align_to<size_t>(size, alignment);
+		return result;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		if(align > _priv::virtual_memory::page_size())
+			return {};
+		auto& header = header_ref();
+		// the payload is a multiple of the alignment, so that the end of the block (its tail) is aligned as well.
+		auto payload = std::max(this->alignment(), sizeof(block_t));
+		auto bytes	 = psl::align_to<std::uint64_t>(std::max<size_t>(size, 1), payload) + sizeof(block_t);
+
+		// first fit from the free blocks, which only offer 16 byte alignment.
+		if(align <= sizeof(block_t)) {
+			for(std::uint64_t* link = &header.free_list; *link != 0; link = &block_at(*link).next) {
+				auto offset = *link;
+				auto& block = block_at(offset);
+				if(block.size < bytes)
+					continue;
+				if(block.size - bytes >= min_block_size) {
+					auto& rest = block_at(offset + bytes);
+					rest	   = {block.size - bytes, block.next};
+					*link	   = offset + bytes;
+					block.size = bytes;
+				} else
+					*link = block.next;
+				block.next	   = 0;
+				auto* location = m_Base + offset + sizeof(block_t);
+				return make_result(location, m_Base + offset + block.size, size, align);
+			}
+		}
+
+		auto start		   = header.top;
+		auto data		   = psl::align_to<std::uint64_t>(start + sizeof(block_t), align);
+		auto end		   = data + bytes - sizeof(block_t);
+		auto header_offset = data - sizeof(block_t);
+		if(end > header.capacity)
+			return {};
+		header.top = end;
+		// a gap in front of the block that is large enough becomes a free block of its own.
+		if(auto gap = header_offset - start; gap >= min_block_size) {
+			block_at(start) = {gap, 0};
+			release_block(start);
+			start = header_offset;
+		}
+		block_at(header_offset) = {end - start, header_offset - start};
+		return make_result(m_Base + data, m_Base + end, size, align);
+	}
+
+	bool do_deallocate(void* ptr, [[maybe_unused]] size_t size, [[maybe_unused]] size_t alignment) override {
+		if(!ptr)
+			return true;
+		if(!owns(ptr))
+			return false;
+		settle(offset(ptr));
+		return true;
+	}
+
+	/**
+	 * \brief Frees the allocation at `offset`, unless a root still refers to it.
+	 * \details The deallocation is then deferred to the root, and the allocation is freed when the root is released.
+	 */
+	void settle(std::uint64_t offset) noexcept {
+		for(auto& root : header_ref().roots) {
+			if(root.offset == offset) {
+				root.released = 1;
+				return;
+			}
+		}
+		release(m_Base + offset);
+	}
+
+	void release(std::byte* location) noexcept {
+		auto block = block_at(offset(location) - sizeof(block_t));
+		auto start = offset(location) - sizeof(block_t) - block.next;
+
+		block_at(start) = {block.size, 0};
+		release_block(start);
+	}
+
+	/**
+	 * \brief Inserts the block at `offset` in the free list, merging it with its neighbours, or gives it back to the
+	 * never allocated space when it is the last block.
+	 */
+	void release_block(std::uint64_t offset) noexcept {
+		auto& header = header_ref();
+		std::uint64_t* previous_link {nullptr};
+		std::uint64_t* link = &header.free_list;
+		while(*link != 0 && *link < offset) {
+			previous_link = link;
+			link		  = &block_at(*link).next;
+		}
+
+		auto& block = block_at(offset);
+		block.next	= *link;
+		*link		= offset;
+		if(block.next != 0 && offset + block.size == block.next) {
+			block.size += block_at(block.next).size;
+			block.next = block_at(block.next).next;
+		}
+		if(previous_link && *previous_link + block_at(*previous_link).size == offset) {
+			auto& previous = block_at(*previous_link);
+			previous.size += block.size;
+			previous.next = block.next;
+			offset		  = *previous_link;
+			link		  = previous_link;
+		}
+		if(offset + block_at(offset).size == header.top) {
+			header.top = offset;
+			*link	   = 0;
+		}
+	}
+
+	_priv::mapped_file::mapping_t m_Mapping {};
+	std::byte* m_Base {nullptr};
+};
+}	 // namespace psl
@@ -0,0 +1,241 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+
+namespace psl {
+/**
+ * \brief Bump-pointer (arena) memory resource.
+ * \details Allocations are served by advancing a cursor through either a caller supplied buffer, or a chain of
+ * blocks sourced from the upstream resource. Individual deallocations are ignored (unless they happen to be the
+ * most recent allocation), instead the whole arena is recycled at once through `reset()`, `rewind()` or
+ * `release()`.
+ * When both a buffer and an upstream are given, the buffer is used first, and the upstream is used to grow once the
+ * buffer has been exhausted.
+ * \warning Objects allocated from the resource are not destroyed when it is reset, this remains the responsibility
+ * of the user.
+ *
+ * \tparam Upstream resource type to source additional blocks from.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class monotonic_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<false>, psl::traits::basic_allocation> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<false>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+	struct block_t {
+		block_t* next {nullptr};
+		std::byte* begin {nullptr};
+		std::byte* end {nullptr};
+		size_t size {0};	// size of the upstream allocation, 0 when not owned by the resource
+	};
+
+  public:
+	using upstream_type = Upstream;
+
+	/**
+	 * \brief Opaque position in the arena, see `marker()` and `rewind()`.
+	 */
+	struct marker_t {
+		block_t* block {nullptr};
+		std::byte* cursor {nullptr};
+	};
+
+	inline constexpr static size_t default_block_size {4096};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] block_size size of the first block requested from the upstream, subsequent blocks grow
+	 * geometrically.
+	 * \param[in] upstream resource used to source the blocks.
+	 */
+	monotonic_resource(size_t alignment,
+					   size_t block_size  = default_block_size,
+					   Upstream* upstream = &psl::default_memory_resource) noexcept
+		: base_type(alignment), m_Upstream(upstream), m_InitialBlockSize(block_size), m_NextBlockSize(block_size) {}
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] buffer caller owned storage to allocate from, it has to outlive the resource.
+	 * \param[in] size size of the buffer in bytes.
+	 * \param[in] upstream optional resource to grow into when the buffer is exhausted, when `nullptr` allocations
+	 * beyond the buffer fail.
+	 */
+	monotonic_resource(size_t alignment, void* buffer, size_t size, Upstream* upstream = nullptr) noexcept
+		: base_type(alignment), m_Upstream(upstream), m_InitialBlockSize(std::max(size, default_block_size)),
+		  m_NextBlockSize(m_InitialBlockSize) {
+		m_Buffer.begin = (std::byte*)buffer;
+		m_Buffer.end   = m_Buffer.begin + size;
+		m_Head		   = &m_Buffer;
+		m_Current	   = m_Head;
+		m_Cursor	   = m_Buffer.begin;
+	}
+
+	~monotonic_resource() { release(); }
+
+	monotonic_resource(monotonic_resource const&)			 = delete;
+	monotonic_resource(monotonic_resource&&)				 = delete;
+	monotonic_resource& operator=(monotonic_resource const&) = delete;
+	monotonic_resource& operator=(monotonic_resource&&)		 = delete;
+
+	/**
+	 * \returns the current position in the arena, which can later be restored using `rewind()`.
+	 */
+	marker_t marker() const noexcept { return {m_Current, m_Cursor}; }
+
+	/**
+	 * \brief Frees every allocation that happened after the marker was taken.
+	 * \details Blocks that were acquired after the marker are kept around to be reused.
+	 * \warning markers are invalidated by `release()`, and by rewinding to an earlier marker.
+	 */
+	void rewind(marker_t marker) noexcept {
+		if(!marker.block) {
+			reset();
+			return;
+		}
+		m_Current = marker.block;
+		m_Cursor  = marker.cursor;
+	}
+
+	/**
+	 * \brief Frees all allocations in O(1), while keeping the acquired blocks around for reuse.
+	 */
+	void reset() noexcept {
+		m_Current = m_Head;
+		m_Cursor  = (m_Head) ? m_Head->begin : nullptr;
+	}
+
+	/**
+	 * \brief Frees all allocations and returns all blocks to the upstream resource.
+	 */
+	void release() noexcept {
+		for(auto* block = m_Head; block != nullptr;) {
+			auto* next = block->next;
+			if(block->size != 0)
+				m_Upstream->deallocate(block, block->size, alignof(block_t));
+			block = next;
+		}
+		m_Buffer.next	= nullptr;
+		m_Head			= (m_Buffer.begin) ? &m_Buffer : nullptr;
+		m_NextBlockSize = m_InitialBlockSize;
+		reset();
+	}
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+
+  private:
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align			= std::lcm(alignment, this->alignment());
+		auto aligned_bytes	= psl::align_to<size_t>(size, this->alignment());
+		std::byte* location = (m_Current) ? bump(m_Current, m_Cursor, aligned_bytes, align) : nullptr;
+
+		while(!location && m_Current && m_Current->next) {
+			m_Current = m_Current->next;
+			m_Cursor  = m_Current->begin;
+			location  = bump(m_Current, m_Cursor, aligned_bytes, align);
+		}
+
+		if(!location) {
+			if(!grow(aligned_bytes, align))
+				return {};
+			location = bump(m_Current, m_Cursor, aligned_bytes, align);
+		}
+
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + aligned_bytes;
+		result.stride = psl::align_to<size_t>(size, align);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, [[maybe_unused]] size_t alignment) override {
+		// the most recent allocation can be given back, everything else is reclaimed in bulk.
+		auto* location = (std::byte*)ptr;
+		if(m_Current && location >= m_Current->begin &&
+		   location + psl::align_to<size_t>(size, this->alignment()) == m_Cursor)
+			m_Cursor = location;
+		return true;
+	}
+
+	size_t do_allocate_batch(size_t size, size_t alignment, size_t count, void** items) override {
+		if(count == 0)
+			return 0;
+
+		// the whole batch is bumped as one range, spaced so that every block keeps its alignment.
+		auto align			= std::lcm(alignment, this->alignment());
+		auto aligned_bytes	= psl::align_to<size_t>(size, this->alignment());
+		auto stride			= psl::align_to<size_t>(aligned_bytes, align);
+		auto total			= stride * (count - 1) + aligned_bytes;
+		std::byte* location = (m_Current) ? bump(m_Current, m_Cursor, total, align) : nullptr;
+		if(!location && !(m_Current && m_Current->next) && grow(total, align))
+			location = bump(m_Current, m_Cursor, total, align);
+		if(!location)
+			return base_type::do_allocate_batch(size, alignment, count, items);
+
+		for(size_t i = 0; i < count; ++i) items[i] = location + i * stride;
+		return count;
+	}
+
+	bool do_deallocate_batch(void* const* items, size_t count, size_t size, size_t alignment) override {
+		// walking the batch back to front gives back the complete batch (including the padding between its blocks)
+		// when it was the most recent allocation.
+		auto align		   = std::lcm(alignment, this->alignment());
+		auto aligned_bytes = psl::align_to<size_t>(size, this->alignment());
+		for(size_t i = count; i > 0 && m_Current; --i) {
+			auto* location = (std::byte*)items[i - 1];
+			auto* end	   = location + aligned_bytes;
+			if(location >= m_Current->begin && end <= m_Cursor &&
+			   (std::byte*)psl::align_to<std::uintptr_t>((std::uintptr_t)end, align) >= m_Cursor)
+				m_Cursor = location;
+		}
+		return true;
+	}
+
+	std::byte* bump(block_t* block, std::byte*& cursor, size_t size, size_t alignment) noexcept {
+		auto* location = (std::byte*)psl::align_to<std::uintptr_t>((std::uintptr_t)cursor, alignment);
+		if(location + size > block->end || location < cursor)
+			return nullptr;
+		cursor = location + size;
+		return location;
+	}
+
+	bool grow(size_t size, size_t alignment) {
+		if(!m_Upstream)
+			return false;
+
+		auto required = sizeof(block_t) + size + alignment;
+		auto bytes	  = std::max(m_NextBlockSize, required);
+		auto res	  = m_Upstream->allocate(bytes, alignof(block_t));
+		if(!res)
+			return false;
+		m_NextBlockSize = bytes * 2;
+
+		auto* block	 = new(res.data) block_t {};
+		block->begin = (std::byte*)res.data + sizeof(block_t);
+		block->end	 = (std::byte*)res.data + bytes;
+		block->size	 = bytes;
+
+		// the new block is inserted after the current one, so that spare blocks (from a rewind) stay reachable.
+		if(m_Current) {
+			block->next		 = m_Current->next;
+			m_Current->next = block;
+		} else {
+			block->next = m_Head;
+			m_Head		= block;
+		}
+		m_Current = block;
+		m_Cursor  = block->begin;
+		return true;
+	}
+
+	Upstream* m_Upstream {nullptr};
+	block_t m_Buffer {};
+	block_t* m_Head {nullptr};
+	block_t* m_Current {nullptr};
+	std::byte* m_Cursor {nullptr};
+	size_t m_InitialBlockSize {default_block_size};
+	size_t m_NextBlockSize {default_block_size};
+};
+}	 // namespace psl
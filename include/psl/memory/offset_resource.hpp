@@ -0,0 +1,206 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <set>
+
+namespace psl {
+/**
+ * \brief Bookkeeping-only memory resource that hands out ranges of a region it never dereferences.
+ * \details Intended to sub-allocate memory the host cannot touch (such as a GPU heap), the region only needs to be a
+ * unique base address, and allocations are best used through their offset into it (see `offset()`).
+ * Free ranges are kept in two balanced trees, one ordered by size (to find the best fit) and one by offset (to merge
+ * a freed range with its neighbours), so allocating and deallocating are O(log n) in the amount of free ranges. An
+ * allocation is served by the smallest free range that is large enough, when that range can't fit the alignment the
+ * smallest range that fits it regardless of where it starts is used instead. The unused front and back of the range
+ * remain free.
+ * The region is carved in granules of `granularity` bytes, every allocation spans a whole amount of granules. The
+ * reported `alloc_results::tail` is the end of the allocation, so containers can make use of the slack.
+ * Deallocating a range that is (partially) free, or that falls outside the region, fails.
+ * \note The resource is not synchronized, use it from one thread at a time.
+ */
+class offset_resource : public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+															psl::traits::basic_allocation,
+															psl::traits::queryable_size_t,
+															psl::traits::physically_allocated_t<false>> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::queryable_size_t,
+												   psl::traits::physically_allocated_t<false>>;
+	friend struct _priv::resource_access;
+
+	struct range_t {
+		size_t size;
+		size_t offset;
+
+		friend bool operator<(range_t const& lhs, range_t const& rhs) noexcept {
+			return (lhs.size != rhs.size) ? lhs.size < rhs.size : lhs.offset < rhs.offset;
+		}
+	};
+
+  public:
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] region base address of the region, this is never dereferenced.
+	 * \param[in] size size of the region in bytes, this gets rounded down to the granularity.
+	 * \param[in] granularity smallest unit of allocation, this gets rounded up to a power of 2.
+	 */
+	offset_resource(size_t alignment, void* region, size_t size, size_t granularity = 256)
+		: base_type(alignment), m_Region((std::uintptr_t)region),
+		  m_Granularity(std::lcm(std::bit_ceil(std::max<size_t>(granularity, 1)), alignment)),
+		  m_Size(size - size % m_Granularity) {
+		PSL_EXCEPT_IF(!region, std::runtime_error, "offset_resource requires a base address");
+		PSL_EXCEPT_IF(m_Region % m_Granularity != 0,
+					  std::runtime_error,
+					  "offset_resource region has to be aligned to the granularity");
+		PSL_EXCEPT_IF(m_Size == 0, std::runtime_error, "offset_resource region is too small");
+		insert(0, m_Size);
+		m_Available = m_Size;
+	}
+
+	offset_resource(offset_resource const&)			   = delete;
+	offset_resource(offset_resource&&)				   = delete;
+	offset_resource& operator=(offset_resource const&) = delete;
+	offset_resource& operator=(offset_resource&&)	   = delete;
+
+	size_t granularity() const noexcept { return m_Granularity; }
+
+	/**
+	 * \returns the size in bytes of the managed region.
+	 */
+	size_t size() const noexcept override { return m_Size; }
+
+	/**
+	 * \returns the amount of free bytes.
+	 */
+	size_t available() const noexcept { return m_Available; }
+
+	/**
+	 * \returns the size of the largest free range, i.e. the largest allocation that can succeed (ignoring alignment).
+	 */
+	size_t largest_available() const noexcept { return (m_BySize.empty()) ? 0 : m_BySize.rbegin()->size; }
+
+	/**
+	 * \returns the amount of disjoint free ranges.
+	 */
+	size_t fragments() const noexcept { return m_BySize.size(); }
+
+	/**
+	 * \returns the offset of `location` into the region.
+	 */
+	size_t offset(void const* location) const noexcept { return (size_t)((std::uintptr_t)location - m_Region); }
+
+  private:
+	void insert(size_t offset, size_t size) {
+		m_BySize.emplace(size, offset);
+		m_ByOffset.emplace(offset, size);
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(std::lcm(alignment, this->alignment()), m_Granularity);
+		auto bytes = psl::align_to<size_t>(std::max<size_t>(size, 1), m_Granularity);
+		if(bytes > m_Available)
+			return {};
+
+		// the smallest range that is large enough is the best fit, unless aligning the allocation pushes it past the
+		// end. Ranges start on a granule, so one of at least `bytes + align - granularity` always fits.
+		auto aligned_begin = [this, align](range_t const& range) {
+			return (size_t)(psl::align_to<std::uintptr_t>(m_Region + range.offset, align) - m_Region);
+		};
+		auto it = m_BySize.lower_bound(range_t {bytes, 0});
+		if(it != m_BySize.end() && aligned_begin(*it) - it->offset + bytes > it->size)
+			it = m_BySize.lower_bound(range_t {bytes + align - m_Granularity, 0});
+		if(it == m_BySize.end())
+			return {};
+		auto begin = aligned_begin(*it);
+
+		auto range = *it;
+		auto front = begin - range.offset;
+		auto back  = range.size - front - bytes;
+
+		// the nodes of the chosen range are reused for its remainder, so that the steady state doesn't allocate.
+		auto size_node	 = m_BySize.extract(it);
+		auto offset_node = m_ByOffset.extract(range.offset);
+		if(front != 0) {
+			size_node.value() = range_t {front, range.offset};
+			m_BySize.insert(std::move(size_node));
+			offset_node.mapped() = front;
+			m_ByOffset.insert(std::move(offset_node));
+			if(back != 0)
+				insert(begin + bytes, back);
+		} else if(back != 0) {
+			size_node.value() = range_t {back, begin + bytes};
+			m_BySize.insert(std::move(size_node));
+			offset_node.key()	 = begin + bytes;
+			offset_node.mapped() = back;
+			m_ByOffset.insert(std::move(offset_node));
+		}
+		m_Available -= bytes;
+
+		auto* location = (std::byte*)(m_Region + begin);
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + bytes;
+		result.stride = psl::align_to<size_t>(size, std::lcm(alignment, this->alignment()));
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, [[maybe_unused]] size_t alignment) override {
+		if(!ptr)
+			return true;
+		auto location = (std::uintptr_t)ptr;
+		auto bytes	  = psl::align_to<size_t>(std::max<size_t>(size, 1), m_Granularity);
+		if(location < m_Region || (location - m_Region) % m_Granularity != 0 || location - m_Region + bytes > m_Size)
+			return false;
+
+		auto offset = (size_t)(location - m_Region);
+		auto next	= m_ByOffset.lower_bound(offset);
+		auto prev	= (next == m_ByOffset.begin()) ? m_ByOffset.end() : std::prev(next);
+		if((next != m_ByOffset.end() && next->first < offset + bytes) ||
+		   (prev != m_ByOffset.end() && prev->first + prev->second > offset))
+			return false;
+		m_Available += bytes;
+
+		auto merge_prev = prev != m_ByOffset.end() && prev->first + prev->second == offset;
+		auto merge_next = next != m_ByOffset.end() && next->first == offset + bytes;
+		if(merge_prev && merge_next) {
+			bytes += next->second;
+			m_BySize.erase(range_t {next->second, next->first});
+			m_ByOffset.erase(next);
+		}
+		if(merge_prev) {
+			auto size_node	  = m_BySize.extract(range_t {prev->second, prev->first});
+			size_node.value() = range_t {prev->second + bytes, prev->first};
+			prev->second	  = size_node.value().size;
+			m_BySize.insert(std::move(size_node));
+		} else if(merge_next) {
+			// the freed range takes the place of the next one, its position in `m_ByOffset` doesn't change.
+			bytes += next->second;
+			auto size_node	  = m_BySize.extract(range_t {next->second, next->first});
+			size_node.value() = range_t {bytes, offset};
+			m_BySize.insert(std::move(size_node));
+			auto offset_node	 = m_ByOffset.extract(next++);
+			offset_node.key()	 = offset;
+			offset_node.mapped() = bytes;
+			m_ByOffset.insert(next, std::move(offset_node));
+		} else {
+			m_BySize.emplace(bytes, offset);
+			m_ByOffset.emplace_hint(next, offset, bytes);
+		}
+		return true;
+	}
+
+	std::uintptr_t m_Region {0};
+	size_t m_Granularity {1};
+	size_t m_Size {0};
+	size_t m_Available {0};
+	std::set<range_t> m_BySize {};
+	std::map<size_t, size_t> m_ByOffset {};	   // offset -> size of every free range
+};
+}	 // namespace psl
@@ -0,0 +1,196 @@
+#pragma once
+#include <array>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/size_classes.hpp>
+
+namespace psl {
+/**
+ * \brief Segregated-fit pool memory resource for small objects.
+ * \details Requests up to `max_pooled_size` are rounded up to a size class, and served from slabs dedicated to that
+ * size class. Freed slots are kept in an intrusive free list per size class, so that both allocation and
+ * deallocation are O(1) and never touch the upstream resource in the steady state. Requests that are larger, or
+ * require more alignment than a size class can offer, are forwarded to the upstream resource.
+ * See `_priv::size_classes` for the available size classes.
+ * The returned `alloc_results::tail` reflects the full size of the slot, so containers can make use of the slack.
+ * \note The resource is not synchronized, use it from one thread at a time.
+ *
+ * \tparam Upstream resource type to source the slabs (and large allocations) from.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class pool_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+	struct free_slot_t {
+		free_slot_t* next;
+	};
+
+	struct slab_t {
+		slab_t* next {nullptr};
+		size_t size {0};
+	};
+
+	struct size_class_t {
+		free_slot_t* free {nullptr};
+		std::byte* cursor {nullptr};
+		std::byte* end {nullptr};
+	};
+
+  public:
+	using upstream_type = Upstream;
+
+	inline constexpr static size_t min_pooled_size {_priv::size_classes::min_size};
+	inline constexpr static size_t max_pooled_size {_priv::size_classes::max_size};
+	inline constexpr static size_t default_slab_size {64 * 1024};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] slab_size size of the slabs requested from the upstream resource, every slab services one size
+	 * class.
+	 * \param[in] upstream resource used to source slabs and large allocations.
+	 */
+	pool_resource(size_t alignment,
+				  size_t slab_size	 = default_slab_size,
+				  Upstream* upstream = &psl::default_memory_resource) noexcept
+		: base_type(alignment), m_Upstream(upstream),
+		  m_SlabSize(
+			psl::align_to<size_t>(std::max(slab_size, max_pooled_size * 4 + sizeof(slab_t)), slab_alignment)) {}
+
+	~pool_resource() { release(); }
+
+	pool_resource(pool_resource const&)			   = delete;
+	pool_resource(pool_resource&&)				   = delete;
+	pool_resource& operator=(pool_resource const&) = delete;
+	pool_resource& operator=(pool_resource&&)	   = delete;
+
+	/**
+	 * \brief Returns all slabs to the upstream resource, invalidating every pooled allocation.
+	 */
+	void release() noexcept {
+		for(auto* slab = m_Slabs; slab != nullptr;) {
+			auto* next = slab->next;
+			auto* data = (std::byte*)(slab + 1) - slab->size;
+			m_Upstream->deallocate(data, slab->size, slab_alignment);
+			slab = next;
+		}
+		m_Slabs	  = nullptr;
+		m_Classes = {};
+	}
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+
+	/**
+	 * \returns the size of the slot that would service an allocation of the given size, or 0 when the allocation
+	 * would be forwarded to the upstream resource.
+	 */
+	size_t slot_size(size_t size, size_t alignment) const noexcept {
+		auto index = _priv::size_classes::index(size, std::lcm(alignment, this->alignment()));
+		return (index == _priv::size_classes::npos) ? 0 : _priv::size_classes::size(index);
+	}
+
+  private:
+	inline constexpr static size_t slab_alignment {max_pooled_size};
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		auto index = _priv::size_classes::index(size, align);
+		if(index == _priv::size_classes::npos)
+			return m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto& size_class = m_Classes[index];
+		auto slot_size	 = _priv::size_classes::size(index);
+		std::byte* location {nullptr};
+		if(size_class.free) {
+			location		= (std::byte*)size_class.free;
+			size_class.free = size_class.free->next;
+		} else {
+			if(size_class.cursor + slot_size > size_class.end && !refill(size_class))
+				return {};
+			location		  = size_class.cursor;
+			size_class.cursor = size_class.cursor + slot_size;
+		}
+
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + slot_size;
+		result.stride = psl::align_to<size_t>(size, align);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		auto align = std::lcm(alignment, this->alignment());
+		auto index = _priv::size_classes::index(size, align);
+		if(index == _priv::size_classes::npos)
+			return m_Upstream->deallocate(ptr, psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto* slot			   = new(ptr) free_slot_t {m_Classes[index].free};
+		m_Classes[index].free = slot;
+		return true;
+	}
+
+	size_t do_allocate_batch(size_t size, size_t alignment, size_t count, void** items) override {
+		auto align = std::lcm(alignment, this->alignment());
+		auto index = _priv::size_classes::index(size, align);
+		if(index == _priv::size_classes::npos)
+			return base_type::do_allocate_batch(size, alignment, count, items);
+
+		// drain the free list first, and carve the remainder from the slab, refilling at most once per slab.
+		auto& size_class = m_Classes[index];
+		auto slot_size	 = _priv::size_classes::size(index);
+		size_t i		 = 0;
+		for(; i < count && size_class.free; ++i) {
+			items[i]		= size_class.free;
+			size_class.free = size_class.free->next;
+		}
+		while(i < count) {
+			if(size_class.cursor + slot_size > size_class.end && !refill(size_class))
+				return i;
+			auto available = (size_t)(size_class.end - size_class.cursor) / slot_size;
+			for(auto last = std::min(count, i + available); i < last; ++i) {
+				items[i]		  = size_class.cursor;
+				size_class.cursor = size_class.cursor + slot_size;
+			}
+		}
+		return count;
+	}
+
+	bool do_deallocate_batch(void* const* items, size_t count, size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		auto index = _priv::size_classes::index(size, align);
+		if(index == _priv::size_classes::npos)
+			return base_type::do_deallocate_batch(items, count, size, alignment);
+
+		auto& size_class = m_Classes[index];
+		for(size_t i = 0; i < count; ++i) {
+			if(items[i])
+				size_class.free = new(items[i]) free_slot_t {size_class.free};
+		}
+		return true;
+	}
+
+	bool refill(size_class_t& size_class) {
+		auto res = m_Upstream->allocate(m_SlabSize, slab_alignment);
+		if(!res)
+			return false;
+
+		// the slab header lives at the end, so that slots start at the (highly aligned) beginning of the slab.
+		auto* data		  = (std::byte*)res.data;
+		auto* slab		  = new(data + m_SlabSize - sizeof(slab_t)) slab_t {m_Slabs, m_SlabSize};
+		m_Slabs			  = slab;
+		size_class.cursor = data;
+		size_class.end	  = (std::byte*)slab;
+		return true;
+	}
+
+	Upstream* m_Upstream {nullptr};
+	size_t m_SlabSize {default_slab_size};
+	slab_t* m_Slabs {nullptr};
+	std::array<size_class_t, _priv::size_classes::count> m_Classes {};
+};
+}	 // namespace psl
@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/combined_traits.hpp>
+#include <tuple>
+
+namespace psl {
+/**
+ * \brief Routes the allocations up to `Threshold` bytes to one resource, and the larger ones to another.
+ * \details Both resources are owned by the segregator. The deallocations are routed on their size, so the reported
+ * `alloc_results::tail` of the small allocations is clamped to `Threshold` bytes, rounded down to the alignment.
+ * The resource is only shareable (or size queryable) when both resources are.
+ *
+ * \tparam Threshold largest size (in bytes) that is served by `Small`.
+ * \tparam Small resource for the allocations of at most `Threshold` bytes.
+ * \tparam Large resource for the allocations larger than `Threshold` bytes.
+ */
+template <size_t Threshold, IsMemoryResource Small, IsMemoryResource Large>
+class segregator_resource
+	: public _priv::combined_resource_t<segregator_resource<Threshold, Small, Large>, Small, Large> {
+	using base_type = _priv::combined_resource_t<segregator_resource<Threshold, Small, Large>, Small, Large>;
+	friend struct _priv::resource_access;
+	friend base_type;
+
+  public:
+	using small_type = Small;
+	using large_type = Large;
+
+	inline constexpr static size_t threshold {Threshold};
+
+	/**
+	 * \brief Constructs both resources from just the alignment.
+	 */
+	segregator_resource(size_t alignment) : base_type(alignment), m_Small(alignment), m_Large(alignment) {}
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] small constructor arguments of the small resource.
+	 * \param[in] large constructor arguments of the large resource.
+	 */
+	template <typename... SmallArgs, typename... LargeArgs>
+	segregator_resource(size_t alignment, std::tuple<SmallArgs...> small, std::tuple<LargeArgs...> large)
+		: base_type(alignment), m_Small(std::make_from_tuple<Small>(std::move(small))),
+		  m_Large(std::make_from_tuple<Large>(std::move(large))) {}
+
+	segregator_resource(segregator_resource const&)			   = delete;
+	segregator_resource(segregator_resource&&)				   = delete;
+	segregator_resource& operator=(segregator_resource const&) = delete;
+	segregator_resource& operator=(segregator_resource&&)	   = delete;
+
+	Small& small() noexcept { return m_Small; }
+	Small const& small() const noexcept { return m_Small; }
+	Large& large() noexcept { return m_Large; }
+	Large const& large() const noexcept { return m_Large; }
+
+  private:
+	size_t combined_size() const noexcept { return m_Small.size() + m_Large.size(); }
+
+	/**
+	 * \returns true when `size` is served by `Large`. The size is rounded up to the alignment first, so that every size
+	 * between the requested and the reported one takes the same route even when `Threshold` is not a multiple of it.
+	 */
+	bool is_large(size_t size) const noexcept { return psl::align_to<size_t>(size, this->alignment()) > Threshold; }
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		if(is_large(size))
+			return m_Large.allocate(size, align);
+		auto result = m_Small.allocate(size, align);
+		if(result)
+			result.tail =
+			  std::min(result.tail, (std::byte*)result.data + psl::ralign_to(Threshold, this->alignment()));
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		return is_large(size) ? m_Large.deallocate(ptr, size, align) : m_Small.deallocate(ptr, size, align);
+	}
+
+	size_t do_allocate_batch(size_t size, size_t alignment, size_t count, void** items) override {
+		auto align = std::lcm(alignment, this->alignment());
+		return is_large(size) ? m_Large.allocate_batch(size, align, count, items)
+								  : m_Small.allocate_batch(size, align, count, items);
+	}
+
+	bool do_deallocate_batch(void* const* items, size_t count, size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		return is_large(size) ? m_Large.deallocate_batch(items, count, size, align)
+								  : m_Small.deallocate_batch(items, count, size, align);
+	}
+
+	Small m_Small;
+	Large m_Large;
+};
+}	 // namespace psl
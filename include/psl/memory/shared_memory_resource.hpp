@@ -0,0 +1,398 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/mapped_file.hpp>
+#include <psl/details/virtual_memory.hpp>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace psl {
+/**
+ * \brief Header at the start of a shared memory object managed by a `shared_memory_resource`.
+ * \details All bookkeeping is stored as offsets from the start of the object, so that every process can map it at a
+ * different address. The fields that change after creation are lock-free atomics, which are address free, and so
+ * synchronize between processes as well as between threads.
+ */
+struct shared_memory_header_t {
+	inline constexpr static char magic_value[8] {'P', 'S', 'L', 'S', 'H', 'M', 'E', 'M'};
+	inline constexpr static std::uint32_t current_version {1};
+	inline constexpr static std::uint32_t byte_order_value {0x01020304};
+	inline constexpr static size_t root_count {16};
+	inline constexpr static size_t class_count {40};
+
+	/**
+	 * \brief Named entry point into the shared memory, see `shared_memory_resource::set_root`.
+	 */
+	struct root_t {
+		std::atomic<std::uint64_t> offset;	 // 0 when the root is not set.
+		std::atomic<std::uint64_t> count;
+		std::atomic<std::uint64_t> element;	 // element size in the upper, and alignment in the lower 32 bits.
+		std::atomic<std::uint64_t> block;	 // size of the block once its deallocation was deferred by the root.
+	};
+
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t header_size;
+	std::uint32_t byte_order;
+	std::uint32_t pointer_size;
+	std::uint64_t layout;	 // user defined tag, checked when the object is opened.
+	std::uint64_t capacity;
+	std::uint64_t reserved;
+	std::atomic<std::uint64_t> ready;	 // set once the creator finished writing the header.
+	std::atomic<std::uint64_t> top;		 // offset of the first byte that was never allocated.
+	std::atomic<std::uint64_t> free_lists[class_count];	 // tagged heads of the free blocks of every size class.
+	root_t roots[root_count];
+};
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+			  "shared memory needs address free atomics, which only lock-free atomics are");
+static_assert(sizeof(shared_memory_header_t) % 16 == 0);
+
+/**
+ * \brief Lock-free memory resource that allocates out of a named shared memory object, so that several processes on
+ * the same machine can share allocations without serialization.
+ * \details Every allocation is rounded up to a power of two size class (of at least 16 bytes), and placed at an
+ * address aligned to its size (up to the page size). Every size class keeps a lock-free list of its free blocks, new
+ * blocks are carved from the never allocated space at the end by advancing an atomic offset. The free list heads are
+ * tagged with a counter to avoid the ABA problem, so any number of threads in any number of processes can allocate and
+ * deallocate concurrently. The size classes trade up to half of every block for that, and freed blocks are never
+ * merged.
+ *
+ * As every process maps the object at a different address, only trivially copyable types without pointers are
+ * meaningful to share, pointers inside shared data should be stored as offsets (see `offset` and `address`).
+ * Allocations are found by other processes through the roots stored in the header, `set_root` publishes an allocation
+ * (such as the storage of a `psl::array`) in one of the slots, and `root` returns a view of it in any process. A rooted
+ * allocation is pinned, deallocating it is ignored until the root is released, so the container that filled it can be
+ * destroyed without losing the contents, the block is freed once both the root and the container released it.
+ * \note The capacity is fixed when the object is created. The name is removed when the resource that created the object
+ * is destroyed, processes that opened it before keep their mapping.
+ */
+class shared_memory_resource : public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+																   psl::traits::basic_allocation,
+																   psl::traits::queryable_size_t> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::queryable_size_t>;
+	friend struct _priv::resource_access;
+
+	inline constexpr static size_t min_block_size {16};
+	// free list heads store the offset (in units of the minimum block size) in the lower bits, and a tag in the rest.
+	inline constexpr static size_t offset_bits {40};
+	inline constexpr static std::uint64_t offset_mask {(std::uint64_t {1} << offset_bits) - 1};
+
+  public:
+	enum class open_mode {
+		open = 0,			 // open an existing object, fails when it does not exist.
+		create = 1,			 // create a new object, replacing any existing object with the same name.
+		open_or_create = 2,	 // open the object when it exists, create it otherwise.
+	};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation, cannot be larger than the page size.
+	 * \param[in] name name of the shared memory object, portable names start with a `/` and contain no other slashes.
+	 * \param[in] mode whether to open an existing object or create a new one.
+	 * \param[in] capacity size of the object when it is created (rounded up to the page size), ignored when an existing
+	 * object is opened.
+	 * \param[in] layout user defined tag (for example a hash of the shared types) stored in a new object, an existing
+	 * object has to have the same tag.
+	 * \throws std::runtime_error when the object cannot be mapped, or when an existing object was not created by this
+	 * version of the resource, or with a different layout.
+	 * \note An existing object can only be opened once its creator finished constructing its resource.
+	 */
+	shared_memory_resource(
+	  size_t alignment, char const* name, open_mode mode, size_t capacity = 0, std::uint64_t layout = 0)
+		: base_type(alignment), m_Name(name) {
+		PSL_EXCEPT_IF(_priv::virtual_memory::page_size() % alignment != 0,
+					  std::runtime_error,
+					  "shared_memory_resource alignment cannot exceed the page size");
+		if(mode == open_mode::open_or_create) {
+			mode = open_mode::open;
+			if(capacity >= sizeof(shared_memory_header_t) + min_block_size &&
+			   _priv::mapped_file::map_shared(m_Mapping, name, page_aligned(capacity)))
+				mode = open_mode::create;
+		} else if(mode == open_mode::create) {
+			PSL_EXCEPT_IF(capacity < sizeof(shared_memory_header_t) + min_block_size,
+						  std::runtime_error,
+						  "shared_memory_resource capacity is too small");
+			_priv::mapped_file::remove_shared(name);
+			PSL_EXCEPT_IF(!_priv::mapped_file::map_shared(m_Mapping, name, page_aligned(capacity)),
+						  std::runtime_error,
+						  "could not create the shared memory");
+		}
+
+		if(mode == open_mode::create) {
+			m_Base	= (std::byte*)m_Mapping.address;
+			m_Owner = true;
+			auto& header = *new(m_Base) shared_memory_header_t {};
+			std::memcpy(header.magic, shared_memory_header_t::magic_value, sizeof(header.magic));
+			header.version		= shared_memory_header_t::current_version;
+			header.header_size	= sizeof(shared_memory_header_t);
+			header.byte_order	= shared_memory_header_t::byte_order_value;
+			header.pointer_size = sizeof(void*);
+			header.layout		= layout;
+			header.capacity		= m_Mapping.size;
+			header.top.store(sizeof(shared_memory_header_t), std::memory_order_relaxed);
+			header.ready.store(1, std::memory_order_release);
+		} else {
+			PSL_EXCEPT_IF(!_priv::mapped_file::map_shared(m_Mapping, name, 0),
+						  std::runtime_error,
+						  "could not open the shared memory");
+			m_Base = (std::byte*)m_Mapping.address;
+			if(auto* error = validate(layout)) {
+				_priv::mapped_file::unmap(m_Mapping);
+				PSL_EXCEPT(std::runtime_error, error);
+			}
+		}
+	}
+
+	~shared_memory_resource() {
+		_priv::mapped_file::unmap(m_Mapping);
+		if(m_Owner)
+			_priv::mapped_file::remove_shared(m_Name.c_str());
+	}
+
+	shared_memory_resource(shared_memory_resource const&)			 = delete;
+	shared_memory_resource(shared_memory_resource&&)				 = delete;
+	shared_memory_resource& operator=(shared_memory_resource const&) = delete;
+	shared_memory_resource& operator=(shared_memory_resource&&)		 = delete;
+
+	/**
+	 * \returns the size of the shared memory object in bytes.
+	 */
+	size_t size() const noexcept override { return m_Mapping.size; }
+
+	shared_memory_header_t const& header() const noexcept { return *(shared_memory_header_t const*)m_Base; }
+
+	/**
+	 * \returns the size of the blocks that serve allocations of `size` bytes aligned to `alignment`.
+	 */
+	size_t block_size(size_t size, size_t alignment) const noexcept {
+		return std::bit_ceil(std::max({size, alignment, this->alignment(), min_block_size}));
+	}
+
+	/**
+	 * \returns the offset of `location` from the start of the shared memory, which is the same in every process.
+	 */
+	size_t offset(void const* location) const noexcept { return (size_t)((std::byte const*)location - m_Base); }
+
+	/**
+	 * \returns the address of `offset` in this process' mapping of the shared memory.
+	 */
+	template <typename T = void>
+	T* address(size_t offset) const noexcept {
+		return (T*)(m_Base + offset);
+	}
+
+	/**
+	 * \brief Publishes the `count` elements at `data` in the root `slot`, and pins their allocation.
+	 * \details `data` has to be the start of an allocation of this resource, any allocation that was previously
+	 * published in the slot is released (unless it is the same allocation). The contents of `data` are visible to any
+	 * process that observes the root.
+	 */
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	void set_root(size_t slot, T const* data, size_t count) {
+		PSL_EXCEPT_IF(slot >= shared_memory_header_t::root_count, std::out_of_range, "root slot out of range");
+		PSL_EXCEPT_IF(!owns(data), std::runtime_error, "the root has to be an allocation of the resource");
+		auto& root	  = header_ref().roots[slot];
+		auto previous = root.offset.exchange(0, std::memory_order_acq_rel);
+		auto block	  = root.block.exchange(0, std::memory_order_acq_rel);
+		root.count.store(count, std::memory_order_relaxed);
+		root.element.store((std::uint64_t {sizeof(T)} << 32) | alignof(T), std::memory_order_relaxed);
+		if(previous == offset(data))
+			root.block.store(block, std::memory_order_relaxed);
+		root.offset.store(offset(data), std::memory_order_release);
+		if(previous != offset(data) && block != 0)
+			settle(previous, block);
+	}
+
+	/**
+	 * \returns a view of the elements published in the root `slot`, this is empty when the slot is not set.
+	 * \throws std::runtime_error when the root was published with a different element type size or alignment.
+	 */
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	std::span<T> root(size_t slot) const {
+		PSL_EXCEPT_IF(slot >= shared_memory_header_t::root_count, std::out_of_range, "root slot out of range");
+		auto const& root = header().roots[slot];
+		std::uint64_t offset {}, count {}, element {};
+		// the fields are re-read when the root is published again while they were being read.
+		do {
+			offset	= root.offset.load(std::memory_order_acquire);
+			count	= root.count.load(std::memory_order_relaxed);
+			element = root.element.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+		} while(offset != root.offset.load(std::memory_order_relaxed));
+		if(offset == 0)
+			return {};
+		PSL_EXCEPT_IF(element != ((std::uint64_t {sizeof(T)} << 32) | alignof(T)),
+					  std::runtime_error,
+					  "the root was published with a different element type");
+		return {(T*)(m_Base + offset), (size_t)count};
+	}
+
+	/**
+	 * \brief Clears the root `slot`, the allocation it referred to is deallocated when its container already
+	 * released it, and otherwise along with the container.
+	 */
+	void release_root(size_t slot) {
+		PSL_EXCEPT_IF(slot >= shared_memory_header_t::root_count, std::out_of_range, "root slot out of range");
+		auto& root	  = header_ref().roots[slot];
+		auto previous = root.offset.exchange(0, std::memory_order_acq_rel);
+		if(auto block = root.block.exchange(0, std::memory_order_acq_rel); block != 0)
+			settle(previous, block);
+	}
+
+  private:
+	static size_t page_aligned(size_t size) noexcept {
+		return psl::align_to<size_t>(size, _priv::virtual_memory::page_size());
+	}
+
+	/**
+	 * \returns the alignment of a block of `size` bytes, blocks are aligned to their size up to the page size.
+	 */
+	static std::uint64_t block_alignment(std::uint64_t size) noexcept {
+		return std::min<std::uint64_t>(size, _priv::virtual_memory::page_size());
+	}
+
+	static size_t size_class(size_t block_size) noexcept {
+		return (size_t)std::countr_zero(block_size) - std::countr_zero(min_block_size);
+	}
+
+	shared_memory_header_t& header_ref() noexcept { return *(shared_memory_header_t*)m_Base; }
+
+	char const* validate(std::uint64_t layout) const noexcept {
+		if(m_Mapping.size < sizeof(shared_memory_header_t))
+			return "the object is not a psl shared memory object";
+		auto const& header = this->header();
+		if(std::memcmp(header.magic, shared_memory_header_t::magic_value, sizeof(header.magic)) != 0 ||
+		   header.ready.load(std::memory_order_acquire) == 0)
+			return "the object is not a psl shared memory object";
+		if(header.version != shared_memory_header_t::current_version ||
+		   header.header_size != sizeof(shared_memory_header_t))
+			return "the shared memory was created by an incompatible version";
+		if(header.byte_order != shared_memory_header_t::byte_order_value || header.pointer_size != sizeof(void*))
+			return "the shared memory was created on an incompatible platform";
+		if(header.layout != layout)
+			return "the shared memory has a different layout";
+		if(header.capacity > m_Mapping.size)
+			return "the shared memory is corrupt";
+		return nullptr;
+	}
+
+	bool owns(void const* location) const noexcept {
+		return (std::byte const*)location >= m_Base + sizeof(shared_memory_header_t) &&
+			   (std::byte const*)location < m_Base + header().top.load(std::memory_order_relaxed);
+	}
+
+	std::atomic_ref<std::uint64_t> link(std::uint64_t offset) noexcept {
+		return std::atomic_ref<std::uint64_t> {*(std::uint64_t*)(m_Base + offset)};
+	}
+
+	void push(size_t size_class, std::uint64_t offset) noexcept {
+		auto& head = header_ref().free_lists[size_class];
+		auto old   = head.load(std::memory_order_relaxed);
+		std::uint64_t desired {};
+		do {
+			link(offset).store((old & offset_mask) * min_block_size, std::memory_order_relaxed);
+			desired = ((old & ~offset_mask) + (offset_mask + 1)) | (offset / min_block_size);
+		} while(!head.compare_exchange_weak(old, desired, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	std::uint64_t pop(size_t size_class) noexcept {
+		auto& head = header_ref().free_lists[size_class];
+		auto old   = head.load(std::memory_order_acquire);
+		while((old & offset_mask) != 0) {
+			// the block can be taken by another thread in the meantime, which the tag in the head detects.
+			auto next	 = link((old & offset_mask) * min_block_size).load(std::memory_order_relaxed);
+			auto desired = ((old & ~offset_mask) + (offset_mask + 1)) | (next / min_block_size);
+			if(head.compare_exchange_weak(old, desired, std::memory_order_acquire, std::memory_order_acquire))
+				return (old & offset_mask) * min_block_size;
+		}
+		return 0;
+	}
+
+	/**
+	 * \brief Carves a block of `size` bytes from the never allocated space, the gap that its alignment leaves is split
+	 * into free blocks.
+	 */
+	std::uint64_t carve(std::uint64_t size) noexcept {
+		auto& header = header_ref();
+		auto start	 = header.top.load(std::memory_order_relaxed);
+		std::uint64_t offset {};
+		do {
+			offset = psl::align_to<std::uint64_t>(start, block_alignment(size));
+			if(offset + size > header.capacity || offset + size > (offset_mask * min_block_size))
+				return 0;
+		} while(!header.top.compare_exchange_weak(start, offset + size, std::memory_order_relaxed));
+
+		while(start < offset) {
+			auto gap = std::bit_floor(offset - start);
+			while(start % block_alignment(gap) != 0) gap /= 2;
+			push(size_class(gap), start);
+			start += gap;
+		}
+		return offset;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		if(align > _priv::virtual_memory::page_size() || size > (offset_mask * min_block_size))
+			return {};
+		auto block_size = this->block_size(size, align);
+		auto offset		= pop(size_class(block_size));
+		if(offset == 0)
+			offset = carve(block_size);
+		if(offset == 0)
+			return {};
+
+		alloc_results<void> result {};
+		result.data	  = m_Base + offset;
+		result.head	  = m_Base + offset;
+		result.tail	  = m_Base + offset + block_size;
+		result.stride = psl::align_to<size_t>(size, align);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		if(!owns(ptr))
+			return false;
+		// rooted allocations stay alive until their root is released.
+		settle(this->offset(ptr), block_size(size, std::lcm(alignment, this->alignment())));
+		return true;
+	}
+
+	/**
+	 * \brief Frees the block of `block` bytes at `offset`, unless a root still refers to it.
+	 * \details The block is then handed to the root, and freed when the root is released. Whichever side takes the
+	 * size back out of the root frees the block, so it is freed exactly once even when the root is released
+	 * concurrently.
+	 */
+	void settle(std::uint64_t offset, std::uint64_t block) noexcept {
+		for(auto& root : header_ref().roots) {
+			if(root.offset.load(std::memory_order_acquire) != offset)
+				continue;
+			root.block.store(block, std::memory_order_release);
+			if(root.offset.load(std::memory_order_acquire) == offset)
+				return;
+			if(block = root.block.exchange(0, std::memory_order_acq_rel); block == 0)
+				return;
+		}
+		push(size_class(block), offset);
+	}
+
+	_priv::mapped_file::mapping_t m_Mapping {};
+	std::byte* m_Base {nullptr};
+	std::string m_Name;
+	bool m_Owner {false};
+};
+}	 // namespace psl
@@ -0,0 +1,171 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <psl/allocator.hpp>
+#include <psl/completion_token.hpp>
+#include <thread>
+
+namespace psl {
+/**
+ * \brief Simulates the memory of a device that the host only reaches asynchronously, such as a GPU.
+ * \details The memory is sourced from the upstream resource, but is only meant to be accessed through
+ * `write_async` and `read_async`. Every asynchronous operation is queued to a worker thread, which executes them in
+ * order, and takes `latency` plus the time to move the bytes at `bandwidth` per transfer, as a copy engine would. The
+ * host is free to compute in the meantime, which makes the resource suitable to test and measure code that overlaps
+ * transfers with work.
+ * The synchronous `allocate` and `deallocate` are served immediately, deallocating a block that is still used by a
+ * queued transfer should be done with `deallocate_async` instead.
+ * \warning Coroutines that await the operations are resumed on the worker thread. They can queue new operations, but
+ * must not block on them (`synchronize`, or `wait`/`get` on a token), as only the worker could complete them.
+ *
+ * \tparam Upstream resource that holds the simulated device memory.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class simulated_device_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+										  psl::traits::basic_allocation,
+										  psl::traits::async_access_t,
+										  psl::traits::host_readability_t<psl::traits::syncronization::async>,
+										  psl::traits::host_writability_t<psl::traits::syncronization::async>> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::async_access_t,
+												   psl::traits::host_readability_t<psl::traits::syncronization::async>,
+												   psl::traits::host_writability_t<psl::traits::syncronization::async>>;
+	friend struct _priv::resource_access;
+
+  public:
+	using upstream_type = Upstream;
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] latency fixed cost of every transfer.
+	 * \param[in] bandwidth bytes a transfer moves per second, 0 to make transfers only cost their latency.
+	 * \param[in] upstream resource that holds the simulated device memory.
+	 */
+	simulated_device_resource(size_t alignment,
+							  std::chrono::nanoseconds latency = {},
+							  size_t bandwidth				   = 0,
+							  Upstream* upstream			   = &psl::default_memory_resource)
+		: base_type(alignment), m_Upstream(upstream), m_Latency(latency), m_Bandwidth(bandwidth),
+		  m_Worker([this] { run(); }) {}
+
+	/**
+	 * \brief Completes the queued operations, and stops the worker.
+	 */
+	~simulated_device_resource() {
+		{
+			std::lock_guard lock {m_QueueMutex};
+			m_Stopping = true;
+		}
+		m_QueueCondition.notify_one();
+		m_Worker.join();
+	}
+
+	simulated_device_resource(simulated_device_resource const&)			   = delete;
+	simulated_device_resource(simulated_device_resource&&)				   = delete;
+	simulated_device_resource& operator=(simulated_device_resource const&) = delete;
+	simulated_device_resource& operator=(simulated_device_resource&&)	   = delete;
+
+	completion_token<alloc_results<void>> allocate_async(size_t size, size_t alignment) override {
+		return submit<alloc_results<void>>([this, size, alignment] { return do_allocate(size, alignment); });
+	}
+
+	completion_token<bool> deallocate_async(void* location, size_t size, size_t alignment) override {
+		return submit<bool>([this, location, size, alignment] { return do_deallocate(location, size, alignment); });
+	}
+
+	completion_token<bool> write_async(void* destination, void const* source, size_t size) override {
+		return submit<bool>([this, destination, source, size] { return transfer(destination, source, size); });
+	}
+
+	completion_token<bool> read_async(void* destination, void const* source, size_t size) override {
+		return submit<bool>([this, destination, source, size] { return transfer(destination, source, size); });
+	}
+
+	/**
+	 * \brief Blocks until every operation that was queued before the call completed.
+	 * \note can't be called from the worker thread, i.e. from a coroutine that awaited one of the operations.
+	 */
+	void synchronize() {
+		PSL_CONTRACT_EXCEPT_IF(std::this_thread::get_id() == m_Worker.get_id(),
+							   "synchronize would wait on the worker thread it is called from");
+		submit<bool>([] { return true; }).wait();
+	}
+
+	/**
+	 * \returns the amount of queued operations that did not start yet.
+	 */
+	size_t pending() const {
+		std::lock_guard lock {m_QueueMutex};
+		return m_Queue.size();
+	}
+
+	Upstream& upstream() noexcept { return *m_Upstream; }
+
+  private:
+	template <typename T, typename Fn>
+	completion_token<T> submit(Fn&& fn) {
+		completion_source<T> source {};
+		auto token = source.token();
+		{
+			std::lock_guard lock {m_QueueMutex};
+			m_Queue.emplace_back([source = std::move(source), fn = std::forward<Fn>(fn)]() mutable {
+				source.complete(fn());
+			});
+		}
+		m_QueueCondition.notify_one();
+		return token;
+	}
+
+	void run() {
+		std::unique_lock lock {m_QueueMutex};
+		while(true) {
+			m_QueueCondition.wait(lock, [this] { return m_Stopping || !m_Queue.empty(); });
+			if(m_Queue.empty())
+				return;
+			auto operation = std::move(m_Queue.front());
+			m_Queue.pop_front();
+			lock.unlock();
+			operation();
+			lock.lock();
+		}
+	}
+
+	bool transfer(void* destination, void const* source, size_t size) {
+		auto duration = m_Latency;
+		if(m_Bandwidth != 0)
+			duration += std::chrono::nanoseconds {(std::int64_t)((double)size * 1e9 / (double)m_Bandwidth)};
+		if(duration.count() > 0)
+			std::this_thread::sleep_for(duration);
+		std::memcpy(destination, source, size);
+		return true;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		std::lock_guard lock {m_UpstreamMutex};
+		return m_Upstream->allocate(size, std::lcm(alignment, this->alignment()));
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		std::lock_guard lock {m_UpstreamMutex};
+		return m_Upstream->deallocate(ptr, size, std::lcm(alignment, this->alignment()));
+	}
+
+	Upstream* m_Upstream {nullptr};
+	std::mutex m_UpstreamMutex {};
+	std::chrono::nanoseconds m_Latency {};
+	size_t m_Bandwidth {0};
+
+	mutable std::mutex m_QueueMutex {};
+	std::condition_variable m_QueueCondition {};
+	std::deque<std::function<void()>> m_Queue {};
+	bool m_Stopping {false};
+	std::thread m_Worker;
+};
+}	 // namespace psl
@@ -0,0 +1,224 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+
+namespace psl {
+/**
+ * \brief Identifies one of the two ends of a `stack_resource`.
+ */
+enum class stack_end { front = 0, back = 1 };
+
+/**
+ * \brief Double-ended LIFO (stack) memory resource over a single buffer.
+ * \details The buffer is consumed from both ends, the front grows upwards and the back grows downwards, and
+ * allocations fail once they meet. This lets two lifetimes share one buffer without fragmenting it, such as data that
+ * persists for a level at one end, and per-frame scratch data at the other.
+ * The resource itself allocates from the front, `back()` is a resource that allocates from the back (and `front()`
+ * is provided for symmetry).
+ * Positions can be captured with `marker()` and restored with `rewind()`, or through the `scope_t` guard returned by
+ * `scope()`, which rolls back every allocation of that end made during its lifetime. Deallocating the most recent
+ * allocation of an end gives it back, other deallocations are ignored. Every allocation of the back end is followed by
+ * a pointer sized header that holds the position of the end from before the allocation, so that deallocating it gives
+ * back the padding its alignment required as well.
+ * \warning Objects allocated from the resource are not destroyed when rewinding, this remains the responsibility of
+ * the user.
+ *
+ * \tparam Upstream resource type to source the buffer from when the resource owns it.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class stack_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<false>, psl::traits::basic_allocation> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<false>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+  public:
+	using upstream_type = Upstream;
+
+	/**
+	 * \brief Resource view on the back end of the stack.
+	 */
+	class back_type : public base_type {
+		friend class stack_resource;
+		back_type(stack_resource& owner) noexcept : base_type(owner.alignment()), m_Owner(owner) {}
+
+	  public:
+		back_type(back_type const&)			   = delete;
+		back_type(back_type&&)				   = delete;
+		back_type& operator=(back_type const&) = delete;
+		back_type& operator=(back_type&&)	   = delete;
+
+	  private:
+		alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+			return m_Owner.allocate_back(size, alignment);
+		}
+		bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+			return m_Owner.deallocate_back(ptr, size, alignment);
+		}
+
+		stack_resource& m_Owner;
+	};
+
+	/**
+	 * \brief Position of one of the ends, see `marker()` and `rewind()`.
+	 */
+	struct marker_t {
+		stack_end end {stack_end::front};
+		std::byte* cursor {nullptr};
+	};
+
+	/**
+	 * \brief Rewinds its end of the stack to where it was when the scope was created.
+	 */
+	class [[nodiscard]] scope_t {
+	  public:
+		scope_t(stack_resource& resource, stack_end end) noexcept
+			: m_Resource(resource), m_Marker(resource.marker(end)) {}
+		~scope_t() { m_Resource.rewind(m_Marker); }
+
+		scope_t(scope_t const&)			   = delete;
+		scope_t(scope_t&&)				   = delete;
+		scope_t& operator=(scope_t const&) = delete;
+		scope_t& operator=(scope_t&&)	   = delete;
+
+	  private:
+		stack_resource& m_Resource;
+		marker_t m_Marker;
+	};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] buffer caller owned storage to allocate from, it has to outlive the resource.
+	 * \param[in] size size of the buffer in bytes.
+	 */
+	stack_resource(size_t alignment, void* buffer, size_t size) noexcept
+		: base_type(alignment), m_Back(*this), m_Begin((std::byte*)buffer), m_End(m_Begin + size), m_Front(m_Begin),
+		  m_BackCursor(m_End) {}
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] size size of the buffer in bytes, which is allocated from the upstream once.
+	 * \param[in] upstream resource to source the buffer from.
+	 */
+	stack_resource(size_t alignment, size_t size, Upstream* upstream = &psl::default_memory_resource)
+		: base_type(alignment), m_Upstream(upstream), m_Back(*this) {
+		auto res = m_Upstream->allocate(size, alignment);
+		PSL_EXCEPT_IF(!res, std::runtime_error, "could not allocate the stack_resource buffer");
+		m_Begin		 = (std::byte*)res.data;
+		m_End		 = m_Begin + size;
+		m_Front		 = m_Begin;
+		m_BackCursor = m_End;
+	}
+
+	~stack_resource() {
+		if(m_Upstream)
+			m_Upstream->deallocate(m_Begin, (size_t)(m_End - m_Begin), this->alignment());
+	}
+
+	stack_resource(stack_resource const&)			 = delete;
+	stack_resource(stack_resource&&)				 = delete;
+	stack_resource& operator=(stack_resource const&) = delete;
+	stack_resource& operator=(stack_resource&&)		 = delete;
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+
+	stack_resource& front() noexcept { return *this; }
+	back_type& back() noexcept { return m_Back; }
+
+	/**
+	 * \returns the amount of bytes left between the two ends.
+	 */
+	size_t available() const noexcept { return (size_t)(m_BackCursor - m_Front); }
+
+	/**
+	 * \returns the current position of the given end, which can later be restored using `rewind()`.
+	 */
+	marker_t marker(stack_end end = stack_end::front) const noexcept {
+		return {end, (end == stack_end::front) ? m_Front : m_BackCursor};
+	}
+
+	/**
+	 * \brief Frees every allocation of the marker's end that happened after the marker was taken.
+	 * \warning markers are invalidated by rewinding to an earlier marker of the same end.
+	 */
+	void rewind(marker_t marker) noexcept {
+		if(marker.end == stack_end::front)
+			m_Front = marker.cursor;
+		else
+			m_BackCursor = marker.cursor;
+	}
+
+	/**
+	 * \returns a guard that rewinds the given end when it goes out of scope.
+	 */
+	scope_t scope(stack_end end = stack_end::front) noexcept { return scope_t {*this, end}; }
+
+	/**
+	 * \brief Frees all allocations at both ends in O(1).
+	 */
+	void reset() noexcept {
+		m_Front		 = m_Begin;
+		m_BackCursor = m_End;
+	}
+
+  private:
+	alloc_results<void> make_result(std::byte* location, size_t aligned_bytes, size_t size, size_t alignment) {
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + aligned_bytes;
+		result.stride = psl::align_to<size_t>(size, alignment);
+		return result;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align		   = std::lcm(alignment, this->alignment());
+		auto aligned_bytes = psl::align_to<size_t>(size, this->alignment());
+		auto* location	   = (std::byte*)psl::align_to<std::uintptr_t>((std::uintptr_t)m_Front, align);
+		if(location < m_Front || location > m_BackCursor || (size_t)(m_BackCursor - location) < aligned_bytes)
+			return {};
+		m_Front = location + aligned_bytes;
+		return make_result(location, aligned_bytes, size, align);
+	}
+
+	bool do_deallocate(void* ptr, size_t size, [[maybe_unused]] size_t alignment) override {
+		auto* location = (std::byte*)ptr;
+		if(location && location >= m_Begin && location + psl::align_to<size_t>(size, this->alignment()) == m_Front)
+			m_Front = location;
+		return true;
+	}
+
+	alloc_results<void> allocate_back(size_t size, size_t alignment) {
+		auto align		   = std::lcm(alignment, this->alignment());
+		auto aligned_bytes = psl::align_to<size_t>(size, this->alignment());
+		if((size_t)(m_BackCursor - m_Front) < aligned_bytes + back_header_size)
+			return {};
+		auto* location = (std::byte*)psl::ralign_to<std::uintptr_t>(
+		  (std::uintptr_t)(m_BackCursor - aligned_bytes - back_header_size), align);
+		if(location < m_Front)
+			return {};
+		// the header is not necessarily aligned, so it is copied in and out.
+		std::memcpy(location + aligned_bytes, &m_BackCursor, back_header_size);
+		m_BackCursor = location;
+		return make_result(location, aligned_bytes, size, align);
+	}
+
+	bool deallocate_back(void* ptr, size_t size, [[maybe_unused]] size_t alignment) {
+		auto* location = (std::byte*)ptr;
+		if(location && location == m_BackCursor)
+			std::memcpy(&m_BackCursor, location + psl::align_to<size_t>(size, this->alignment()), back_header_size);
+		return true;
+	}
+
+	inline constexpr static size_t back_header_size {sizeof(std::byte*)};
+
+	Upstream* m_Upstream {nullptr};
+	back_type m_Back;
+	std::byte* m_Begin {nullptr};
+	std::byte* m_End {nullptr};
+	std::byte* m_Front {nullptr};
+	std::byte* m_BackCursor {nullptr};
+};
+}	 // namespace psl
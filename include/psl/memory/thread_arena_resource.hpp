@@ -0,0 +1,228 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/size_classes.hpp>
+#include <psl/details/thread_registry.hpp>
+#include <vector>
+
+namespace psl {
+/**
+ * \brief Memory resource that gives every thread its own arena, and returns blocks freed on another thread to the
+ * arena that handed them out.
+ * \details Arenas carve their blocks out of spans of `span_size` bytes (aligned to their size) sourced from the
+ * upstream resource, one size class per span. The span header records the arena that owns it, so a deallocation
+ * finds the owner of a block by masking its address.
+ * Blocks freed by the owning thread go straight back on the arena's free lists. Blocks freed by any other thread are
+ * pushed onto the owner's remote-free list, a lock-free stack that the owner takes as a whole (and sorts into its
+ * free lists) on its next allocation. Only the owner ever pops, so the stack is not subject to the ABA problem.
+ * When a thread exits, its arena is kept alive and is adopted by the next thread that needs one, together with the
+ * blocks that were freed into it in the meantime. Spans are only given back to the upstream when the resource is
+ * destroyed.
+ * Requests larger than `_priv::size_classes::max_size` bypass the arenas.
+ * \warning The upstream resource is used concurrently, and so has to be thread-safe.
+ *
+ * \tparam Upstream resource type to source the spans from.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class thread_arena_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+	struct free_block_t {
+		free_block_t* next;
+	};
+
+	struct arena_t;
+
+	struct span_t {
+		arena_t* owner;
+		size_t index;
+		span_t* next;	 // the previous span of the arena, to release them all on destruction.
+	};
+
+	struct cursor_t {
+		std::byte* next {nullptr};
+		std::byte* end {nullptr};
+	};
+
+	struct arena_t {
+		std::array<free_block_t*, _priv::size_classes::count> free {};
+		std::array<cursor_t, _priv::size_classes::count> cursors {};
+		span_t* spans {nullptr};
+		alignas(64) std::atomic<free_block_t*> remote {nullptr};	// written by the other threads.
+	};
+
+	using registry_type = _priv::thread_registry<thread_arena_resource, arena_t*>;
+	friend registry_type;
+
+  public:
+	using upstream_type = Upstream;
+
+	inline constexpr static size_t span_size {size_t {1} << 16};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] upstream thread-safe resource to source the spans from.
+	 */
+	thread_arena_resource(size_t alignment, Upstream* upstream = &psl::default_memory_resource) noexcept
+		: base_type(alignment), m_Upstream(upstream), m_Registry(*this) {}
+
+	~thread_arena_resource() {
+		m_Registry.release([](arena_t*) {});
+
+		std::lock_guard guard {m_Lock};
+		for(auto& arena : m_Arenas) {
+			for(auto* span = arena->spans; span != nullptr;) {
+				auto* next = span->next;
+				m_Upstream->deallocate(span, span_size, span_size);
+				span = next;
+			}
+		}
+		m_Arenas.clear();
+		m_Orphans.clear();
+	}
+
+	thread_arena_resource(thread_arena_resource const&)			   = delete;
+	thread_arena_resource(thread_arena_resource&&)				   = delete;
+	thread_arena_resource& operator=(thread_arena_resource const&) = delete;
+	thread_arena_resource& operator=(thread_arena_resource&&)	   = delete;
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+
+	/**
+	 * \returns the amount of arenas that were created, which is the highest amount of threads that used the resource
+	 * at the same time.
+	 */
+	size_t arena_count() const noexcept {
+		std::lock_guard guard {m_Lock};
+		return m_Arenas.size();
+	}
+
+  private:
+	static span_t* span_of(void* block) noexcept {
+		return (span_t*)((std::uintptr_t)block & ~(std::uintptr_t)(span_size - 1));
+	}
+
+	/**
+	 * \returns the arena of the calling thread, adopting an orphaned arena (or creating one) when it has none.
+	 */
+	arena_t& local_arena() {
+		return *m_Registry.local([this](arena_t*& arena) {
+			std::lock_guard guard {m_Lock};
+			if(m_Orphans.empty()) {
+				arena = m_Arenas.emplace_back(std::make_unique<arena_t>()).get();
+			} else {
+				arena = m_Orphans.back();
+				m_Orphans.pop_back();
+			}
+		});
+	}
+
+	/**
+	 * \brief Moves the blocks other threads freed into the arena onto its free lists.
+	 */
+	static void drain(arena_t& arena) noexcept {
+		auto* block = arena.remote.exchange(nullptr, std::memory_order_acquire);
+		while(block != nullptr) {
+			auto* next	= block->next;
+			auto& free	= arena.free[span_of(block)->index];
+			block->next = free;
+			free		= block;
+			block		= next;
+		}
+	}
+
+	/**
+	 * \returns a block of the size class that was never handed out, sourcing a new span when the current one ran out.
+	 */
+	std::byte* carve(arena_t& arena, size_t index) {
+		auto size	 = _priv::size_classes::size(index);
+		auto& cursor = arena.cursors[index];
+		if(cursor.next == nullptr || (size_t)(cursor.end - cursor.next) < size) {
+			auto res = m_Upstream->allocate(span_size, span_size);
+			if(!res)
+				return nullptr;
+			auto* span	= new(res.data) span_t {&arena, index, arena.spans};
+			arena.spans = span;
+			cursor.next =
+			  (std::byte*)res.data + psl::align_to<size_t>(sizeof(span_t), _priv::size_classes::alignment(index));
+			cursor.end = (std::byte*)res.data + span_size;
+		}
+		auto* block = cursor.next;
+		cursor.next += size;
+		return block;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		auto index = _priv::size_classes::index(size, align);
+		if(index == _priv::size_classes::npos)
+			return m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto& arena = local_arena();
+		if(arena.remote.load(std::memory_order_relaxed) != nullptr)
+			drain(arena);
+
+		std::byte* location {nullptr};
+		if(auto* head = arena.free[index]; head != nullptr) {
+			arena.free[index] = head->next;
+			location		  = (std::byte*)head;
+		} else if(location = carve(arena, index); location == nullptr) {
+			return {};
+		}
+
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + _priv::size_classes::size(index);
+		result.stride = psl::align_to<size_t>(size, align);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		auto align = std::lcm(alignment, this->alignment());
+		auto index = _priv::size_classes::index(size, align);
+		if(index == _priv::size_classes::npos)
+			return m_Upstream->deallocate(ptr, psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto* span	= span_of(ptr);
+		auto* block = (free_block_t*)ptr;
+		auto& owner = *span->owner;
+		if(auto* local = m_Registry.find(); local && *local == &owner) {
+			block->next				= owner.free[span->index];
+			owner.free[span->index] = block;
+			return true;
+		}
+
+		auto& remote = owner.remote;
+		block->next	 = remote.load(std::memory_order_relaxed);
+		while(!remote.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+			;
+		return true;
+	}
+
+	/**
+	 * \brief Hands the arena of an exiting thread to the next thread that needs one.
+	 */
+	void retire(arena_t* arena) {
+		std::lock_guard guard {m_Lock};
+		m_Orphans.emplace_back(arena);
+	}
+
+	Upstream* m_Upstream {nullptr};
+	mutable std::mutex m_Lock {};
+	std::vector<std::unique_ptr<arena_t>> m_Arenas {};
+	std::vector<arena_t*> m_Orphans {};
+	registry_type m_Registry;
+};
+}	 // namespace psl
@@ -0,0 +1,228 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <mutex>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/size_classes.hpp>
+#include <psl/details/thread_registry.hpp>
+
+namespace psl {
+/**
+ * \brief Thread caching front-end for a thread-safe upstream resource.
+ * \details Every thread that uses the resource gets its own set of magazines (small stacks of free blocks, one per
+ * size class), allocations and deallocations are served from these without any synchronization. When a magazine
+ * overflows, half of it is handed to a shared depot, and an empty magazine is refilled from that depot before
+ * falling back to the upstream resource. Blocks freed on a different thread than the one that allocated them end up
+ * in the freeing thread's magazine, and flow back to other threads through the depot.
+ * When a thread exits, its magazines are returned to the depot. Cached blocks are only given back to the upstream
+ * when the resource is destroyed.
+ * Requests up to `_priv::size_classes::max_size` use the shared size classes. Larger requests, up to `MaxCachedSize`,
+ * are rounded up to a power of two and cached in magazines of `large_magazine_size` blocks, so that a thread only
+ * holds on to a few of them. Anything larger than that, or aligned to more than `_priv::size_classes::max_size`,
+ * bypasses the cache.
+ * \warning The upstream resource is used concurrently, and so has to be thread-safe.
+ *
+ * \tparam Upstream resource type to source the blocks from.
+ * \tparam MaxCachedSize largest request (in bytes) that is cached, a power of two.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t, size_t MaxCachedSize = 64 * 1024>
+	requires(std::has_single_bit(MaxCachedSize) && MaxCachedSize >= _priv::size_classes::max_size)
+class thread_cache_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+	struct free_block_t {
+		free_block_t* next;
+	};
+
+	struct magazine_t {
+		std::array<void*, 64> blocks;
+		size_t count {0};
+	};
+
+	inline constexpr static size_t large_class_count {(size_t)std::bit_width(MaxCachedSize) -
+													 (size_t)std::bit_width(_priv::size_classes::max_size)};
+	inline constexpr static size_t class_count {_priv::size_classes::count + large_class_count};
+	inline constexpr static size_t npos {class_count};
+
+	struct depot_t {
+		free_block_t* head {nullptr};
+		size_t count {0};
+	};
+
+	struct cache_t {
+		std::array<magazine_t, class_count> magazines {};
+	};
+
+	using registry_type = _priv::thread_registry<thread_cache_resource, cache_t>;
+	friend registry_type;
+
+  public:
+	using upstream_type = Upstream;
+
+	inline constexpr static size_t magazine_size {std::tuple_size_v<decltype(magazine_t::blocks)>};
+	inline constexpr static size_t large_magazine_size {8};
+	inline constexpr static size_t max_cached_size {MaxCachedSize};
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] upstream thread-safe resource to source the blocks from.
+	 */
+	thread_cache_resource(size_t alignment, Upstream* upstream = &psl::default_memory_resource) noexcept
+		: base_type(alignment), m_Upstream(upstream), m_Registry(*this) {}
+
+	~thread_cache_resource() {
+		m_Registry.release([this](cache_t& cache) {
+			for(size_t index = 0; index < cache.magazines.size(); ++index) {
+				auto& magazine = cache.magazines[index];
+				for(size_t i = 0; i < magazine.count; ++i) release_block(magazine.blocks[i], index);
+				magazine.count = 0;
+			}
+		});
+
+		std::lock_guard guard {m_Lock};
+		for(size_t index = 0; index < m_Depots.size(); ++index) {
+			for(auto* block = m_Depots[index].head; block != nullptr;) {
+				auto* next = block->next;
+				release_block(block, index);
+				block = next;
+			}
+			m_Depots[index] = {};
+		}
+	}
+
+	thread_cache_resource(thread_cache_resource const&)			   = delete;
+	thread_cache_resource(thread_cache_resource&&)				   = delete;
+	thread_cache_resource& operator=(thread_cache_resource const&) = delete;
+	thread_cache_resource& operator=(thread_cache_resource&&)	   = delete;
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+
+	/**
+	 * \returns the amount of blocks of the size class that can service `size` currently held by the depot.
+	 */
+	size_t depot_size(size_t size, size_t alignment = 1) const noexcept {
+		auto index = class_index(size, std::lcm(alignment, this->alignment()));
+		if(index == npos)
+			return 0;
+		std::lock_guard guard {m_Lock};
+		return m_Depots[index].count;
+	}
+
+  private:
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		auto index = class_index(size, align);
+		if(index == npos)
+			return m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto& magazine = m_Registry.local().magazines[index];
+		if(magazine.count == 0 && !refill(magazine, index))
+			return {};
+
+		auto* location = (std::byte*)magazine.blocks[--magazine.count];
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = location + class_size(index);
+		result.stride = psl::align_to<size_t>(size, align);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		if(!ptr)
+			return true;
+		auto align = std::lcm(alignment, this->alignment());
+		auto index = class_index(size, align);
+		if(index == npos)
+			return m_Upstream->deallocate(ptr, psl::align_to<size_t>(size, this->alignment()), align);
+
+		auto& magazine = m_Registry.local().magazines[index];
+		if(magazine.count == magazine_capacity(index))
+			flush(magazine, index, magazine_capacity(index) / 2);
+		magazine.blocks[magazine.count++] = ptr;
+		return true;
+	}
+
+	/**
+	 * \returns the index of the class that can contain `size` bytes aligned to `alignment`, or `npos` when the request
+	 * bypasses the cache.
+	 * \note like `_priv::size_classes::index`, every size up to the size of the class maps onto the same class.
+	 */
+	static constexpr size_t class_index(size_t size, size_t alignment) noexcept {
+		if(size <= _priv::size_classes::max_size || alignment > _priv::size_classes::max_size)
+			return _priv::size_classes::index(size, alignment);
+		if(size > MaxCachedSize)
+			return npos;
+		return _priv::size_classes::count + (size_t)std::bit_width(size - 1) -
+			   (size_t)std::bit_width(_priv::size_classes::max_size * 2 - 1);
+	}
+
+	static constexpr size_t class_size(size_t index) noexcept {
+		if(index < _priv::size_classes::count)
+			return _priv::size_classes::size(index);
+		return _priv::size_classes::max_size << (index - _priv::size_classes::count + 1);
+	}
+
+	/**
+	 * \returns the alignment the blocks of the class are sourced with, the large classes share the alignment of the
+	 * largest small class rather than their natural alignment, which would waste most of an upstream block.
+	 */
+	static constexpr size_t class_alignment(size_t index) noexcept {
+		return _priv::size_classes::alignment(std::min(index, _priv::size_classes::count - 1));
+	}
+
+	static constexpr size_t magazine_capacity(size_t index) noexcept {
+		return (index < _priv::size_classes::count) ? magazine_size : large_magazine_size;
+	}
+
+	bool refill(magazine_t& magazine, size_t index) {
+		{
+			std::lock_guard guard {m_Lock};
+			auto& depot = m_Depots[index];
+			while(depot.head && magazine.count < magazine_capacity(index) / 2) {
+				magazine.blocks[magazine.count++] = depot.head;
+				depot.head						  = depot.head->next;
+				--depot.count;
+			}
+		}
+
+		while(magazine.count < magazine_capacity(index) / 2) {
+			auto res = m_Upstream->allocate(class_size(index), class_alignment(index));
+			if(!res)
+				break;
+			magazine.blocks[magazine.count++] = res.data;
+		}
+		return magazine.count != 0;
+	}
+
+	void flush(magazine_t& magazine, size_t index, size_t count) {
+		std::lock_guard guard {m_Lock};
+		auto& depot = m_Depots[index];
+		for(; count > 0 && magazine.count > 0; --count) {
+			depot.head = new(magazine.blocks[--magazine.count]) free_block_t {depot.head};
+			++depot.count;
+		}
+	}
+
+	/**
+	 * \brief Moves the blocks of an exiting thread into the depot.
+	 */
+	void retire(cache_t& cache) {
+		for(size_t index = 0; index < cache.magazines.size(); ++index)
+			flush(cache.magazines[index], index, magazine_size);
+	}
+
+	void release_block(void* block, size_t index) {
+		m_Upstream->deallocate(block, class_size(index), class_alignment(index));
+	}
+
+	Upstream* m_Upstream {nullptr};
+	mutable std::mutex m_Lock {};
+	std::array<depot_t, class_count> m_Depots {};
+	registry_type m_Registry;
+};
+}	 // namespace psl
@@ -0,0 +1,286 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+
+namespace psl {
+/**
+ * \brief Two-level segregated fit (TLSF) memory resource over a fixed, user supplied, region.
+ * \details Free blocks are kept in size segregated lists, indexed by a first level (power of two) and a second level
+ * (linear subdivision of that power of two). Two bitmaps track which lists are non-empty, so finding a suitable
+ * block, splitting it and merging it back with its physical neighbours are all done in constant time, regardless of
+ * the amount of live allocations. This makes the resource suitable for general allocation where the worst case
+ * latency matters.
+ * The region is carved in granules of `granularity` bytes, every block spans a whole amount of granules.
+ * When `Physical` is true, the bookkeeping of every block is stored in-band, in the first granule of the block.
+ * When it is false, the resource never touches the region (which can be a simulated range such as a device heap), and
+ * the bookkeeping is stored in an array of records sourced from the upstream resource instead.
+ * The reported `alloc_results::tail` is the end of the block, so containers can make use of the slack.
+ * \note The resource is not synchronized, use it from one thread at a time.
+ *
+ * \tparam Physical true when the region is host memory the resource can store its bookkeeping in.
+ * \tparam Upstream resource type to source the out-of-band bookkeeping from when `Physical` is false.
+ */
+template <bool Physical = true, IsMemoryResource Upstream = config::default_memory_resource_t>
+class tlsf_resource : public psl::traited_memory_resource<psl::traits::shareable_t<true>,
+														  psl::traits::basic_allocation,
+														  psl::traits::queryable_size_t,
+														  psl::traits::physically_allocated_t<Physical>> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>,
+												   psl::traits::basic_allocation,
+												   psl::traits::queryable_size_t,
+												   psl::traits::physically_allocated_t<Physical>>;
+	friend struct _priv::resource_access;
+
+	struct block_t {
+		std::uint32_t size;	   // in granules, the high bit is set while the block is free.
+		std::uint32_t previous_physical;
+		std::uint32_t previous_free;
+		std::uint32_t next_free;
+	};
+
+	inline constexpr static std::uint32_t npos {std::numeric_limits<std::uint32_t>::max()};
+	inline constexpr static std::uint32_t free_flag {std::uint32_t {1} << 31};
+	inline constexpr static size_t max_granules {free_flag - 1};
+	inline constexpr static size_t sl_shift {4};
+	inline constexpr static size_t sl_count {size_t {1} << sl_shift};
+	inline constexpr static size_t fl_count {std::bit_width(max_granules) - sl_shift + 1};
+	inline constexpr static size_t header_granules {Physical ? 1 : 0};
+
+  public:
+	using upstream_type = Upstream;
+
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] region start of the region to manage, this does not have to be dereferenceable when `Physical` is
+	 * false.
+	 * \param[in] size size of the region in bytes.
+	 * \param[in] granularity smallest unit of allocation, this gets rounded up to a power of 2 (and to the size of
+	 * the in-band bookkeeping when `Physical` is true).
+	 * \param[in] upstream resource to source the out-of-band bookkeeping from, unused when `Physical` is true.
+	 */
+	tlsf_resource(size_t alignment,
+				  void* region,
+				  size_t size,
+				  size_t granularity = 16,
+				  Upstream* upstream = &psl::default_memory_resource)
+		: base_type(alignment), m_Upstream(upstream),
+		  m_Granularity(std::lcm(std::bit_ceil(std::max(granularity, Physical ? sizeof(block_t) : size_t {1})),
+								 alignment)) {
+		auto start	= (std::uintptr_t)region;
+		auto offset = psl::align_to<std::uintptr_t>(start, m_Granularity) - start;
+		PSL_EXCEPT_IF(Physical && !region, std::runtime_error, "tlsf_resource requires a region");
+		PSL_EXCEPT_IF(offset >= size || (size - offset) / m_Granularity <= header_granules,
+					  std::runtime_error,
+					  "tlsf_resource region is too small");
+		m_Region = start + offset;
+		m_Count	 = (std::uint32_t)std::min((size - offset) / m_Granularity, max_granules);
+
+		if constexpr(!Physical) {
+			auto records = m_Upstream->allocate(m_Count * sizeof(block_t), alignof(block_t));
+			PSL_EXCEPT_IF(!records, std::runtime_error, "could not allocate the tlsf_resource bookkeeping");
+			m_Blocks = (block_t*)records.data;
+		}
+
+		for(auto& heads : m_Heads) heads.fill(npos);
+		block(0) = block_t {m_Count, npos, npos, npos};
+		insert(0);
+	}
+
+	~tlsf_resource() {
+		if constexpr(!Physical)
+			m_Upstream->deallocate(m_Blocks, m_Count * sizeof(block_t), alignof(block_t));
+	}
+
+	tlsf_resource(tlsf_resource const&)			   = delete;
+	tlsf_resource(tlsf_resource&&)				   = delete;
+	tlsf_resource& operator=(tlsf_resource const&) = delete;
+	tlsf_resource& operator=(tlsf_resource&&)	   = delete;
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+	size_t granularity() const noexcept { return m_Granularity; }
+
+	/**
+	 * \returns the size in bytes of the managed region.
+	 */
+	size_t size() const noexcept override { return (size_t)m_Count * m_Granularity; }
+
+	/**
+	 * \returns the amount of bytes in free blocks (including the space their bookkeeping would take).
+	 */
+	size_t available() const noexcept { return (size_t)m_Free * m_Granularity; }
+
+  private:
+	block_t& block(std::uint32_t index) noexcept {
+		if constexpr(Physical)
+			return *(block_t*)(m_Region + (std::uintptr_t)index * m_Granularity);
+		else
+			return m_Blocks[index];
+	}
+
+	std::uint32_t size_of(std::uint32_t index) noexcept { return block(index).size & ~free_flag; }
+	bool is_free(std::uint32_t index) noexcept { return (block(index).size & free_flag) != 0; }
+	std::uintptr_t payload_of(std::uint32_t index) const noexcept {
+		return m_Region + (std::uintptr_t)(index + header_granules) * m_Granularity;
+	}
+
+	/**
+	 * \brief Maps a size (in granules) to the list it belongs in.
+	 */
+	static std::pair<size_t, size_t> mapping(size_t size) noexcept {
+		if(size < sl_count)
+			return {0, size};
+		auto fl = (size_t)std::bit_width(size) - 1;
+		return {fl - sl_shift + 1, (size >> (fl - sl_shift)) - sl_count};
+	}
+
+	/**
+	 * \brief Maps a size (in granules) to the first list where every block is guaranteed to be large enough.
+	 */
+	static std::pair<size_t, size_t> mapping_search(size_t size) noexcept {
+		if(size >= sl_count)
+			size += (size_t {1} << (std::bit_width(size) - 1 - sl_shift)) - 1;
+		return mapping(size);
+	}
+
+	std::uint32_t find(size_t size) noexcept {
+		auto [fl, sl] = mapping_search(size);
+		if(fl >= fl_count)
+			return npos;
+		auto sl_map = m_SecondLevel[fl] & (~std::uint32_t {0} << sl);
+		if(sl_map == 0) {
+			auto fl_map = (fl + 1 < fl_count) ? m_FirstLevel & (~std::uint32_t {0} << (fl + 1)) : 0;
+			if(fl_map == 0)
+				return npos;
+			fl	   = (size_t)std::countr_zero(fl_map);
+			sl_map = m_SecondLevel[fl];
+		}
+		return m_Heads[fl][(size_t)std::countr_zero(sl_map)];
+	}
+
+	void insert(std::uint32_t index) noexcept {
+		auto& current = block(index);
+		auto [fl, sl] = mapping(current.size & ~free_flag);
+		auto head	  = m_Heads[fl][sl];
+		current.size |= free_flag;
+		current.previous_free = npos;
+		current.next_free	  = head;
+		if(head != npos)
+			block(head).previous_free = index;
+		m_Heads[fl][sl] = index;
+		m_FirstLevel |= std::uint32_t {1} << fl;
+		m_SecondLevel[fl] |= std::uint32_t {1} << sl;
+		m_Free += current.size & ~free_flag;
+	}
+
+	void remove(std::uint32_t index) noexcept {
+		auto& current = block(index);
+		auto [fl, sl] = mapping(current.size & ~free_flag);
+		if(current.previous_free != npos)
+			block(current.previous_free).next_free = current.next_free;
+		else
+			m_Heads[fl][sl] = current.next_free;
+		if(current.next_free != npos)
+			block(current.next_free).previous_free = current.previous_free;
+		if(m_Heads[fl][sl] == npos) {
+			m_SecondLevel[fl] &= ~(std::uint32_t {1} << sl);
+			if(m_SecondLevel[fl] == 0)
+				m_FirstLevel &= ~(std::uint32_t {1} << fl);
+		}
+		current.size &= ~free_flag;
+		m_Free -= current.size;
+	}
+
+	/**
+	 * \brief Splits the (non-free) block at `index` after `size` granules.
+	 * \returns the index of the remainder.
+	 */
+	std::uint32_t split(std::uint32_t index, std::uint32_t size) noexcept {
+		auto remainder	   = index + size;
+		block(remainder)   = block_t {size_of(index) - size, index, npos, npos};
+		block(index).size  = size;
+		if(auto next = remainder + size_of(remainder); next < m_Count)
+			block(next).previous_physical = remainder;
+		return remainder;
+	}
+
+	/**
+	 * \brief Merges the (non-free) block `next` into its physical predecessor `index`.
+	 */
+	void merge(std::uint32_t index, std::uint32_t next) noexcept {
+		block(index).size += size_of(next);
+		if(auto following = index + size_of(index); following < m_Count)
+			block(following).previous_physical = index;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align	  = std::lcm(alignment, this->alignment());
+		auto stride	  = std::lcm(align, m_Granularity);
+		auto payload  = std::max<size_t>((size + m_Granularity - 1) / m_Granularity, 1);
+		auto required = payload + header_granules;
+		auto needed	  = required + stride / m_Granularity - 1;
+		if(needed > m_Count)
+			return {};
+
+		auto index = find(needed);
+		if(index == npos)
+			return {};
+		remove(index);
+
+		auto location = payload_of(index);
+		if(auto gap = (std::uint32_t)((psl::align_to<std::uintptr_t>(location, stride) - location) / m_Granularity);
+		   gap != 0) {
+			auto aligned = split(index, gap);
+			insert(index);
+			index	 = aligned;
+			location = payload_of(index);
+		}
+		if(size_of(index) > required)
+			insert(split(index, (std::uint32_t)required));
+
+		alloc_results<void> result {};
+		result.data	  = (void*)location;
+		result.head	  = (std::byte*)location;
+		result.tail	  = (std::byte*)(m_Region + (std::uintptr_t)(index + size_of(index)) * m_Granularity);
+		result.stride = psl::align_to<size_t>(size, align);
+		return result;
+	}
+
+	bool do_deallocate(void* ptr, size_t, size_t) override {
+		if constexpr(Physical) {
+			if(!ptr)
+				return true;
+		}
+		auto offset = (std::uintptr_t)ptr - m_Region;
+		if((std::uintptr_t)ptr < m_Region || offset >= this->size())
+			return false;
+
+		auto index = (std::uint32_t)(offset / m_Granularity - header_granules);
+		if(auto previous = block(index).previous_physical; previous != npos && is_free(previous)) {
+			remove(previous);
+			merge(previous, index);
+			index = previous;
+		}
+		if(auto next = index + size_of(index); next < m_Count && is_free(next)) {
+			remove(next);
+			merge(index, next);
+		}
+		insert(index);
+		return true;
+	}
+
+	Upstream* m_Upstream {nullptr};
+	size_t m_Granularity {16};
+	std::uintptr_t m_Region {0};
+	std::uint32_t m_Count {0};
+	std::uint32_t m_Free {0};
+	block_t* m_Blocks {nullptr};
+	std::uint32_t m_FirstLevel {0};
+	std::array<std::uint32_t, fl_count> m_SecondLevel {};
+	std::array<std::array<std::uint32_t, sl_count>, fl_count> m_Heads {};
+};
+}	 // namespace psl
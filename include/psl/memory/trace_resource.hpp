@@ -0,0 +1,234 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/thread_registry.hpp>
+#include <vector>
+
+namespace psl {
+/**
+ * \brief Kind of operation recorded in a `trace_event_t`.
+ */
+enum class trace_operation : std::uint8_t { allocate = 0, deallocate = 1, failed_allocate = 2 };
+
+/**
+ * \brief Single allocator operation recorded by a `trace_resource`, this is also the on-disk format.
+ */
+struct trace_event_t {
+	std::uint64_t timestamp;	// nanoseconds since the creation of the recording resource.
+	std::uint64_t address;		// address of the block, 0 for failed allocations.
+	std::uint64_t size;
+	std::uint32_t alignment;
+	std::uint16_t thread;	 // index of the thread in the order it first used the resource.
+	trace_operation operation;
+	std::uint8_t reserved;
+};
+static_assert(sizeof(trace_event_t) == 32 && std::is_trivially_copyable_v<trace_event_t>);
+
+/**
+ * \brief Header of a trace file, followed by the `trace_event_t`'s.
+ */
+struct trace_header_t {
+	inline constexpr static char magic_value[8] {'P', 'S', 'L', 'T', 'R', 'A', 'C', 'E'};
+	inline constexpr static std::uint32_t current_version {1};
+
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t event_size;
+};
+
+/**
+ * \brief Reads a trace file written by a `trace_resource`.
+ * \details The events of every thread are written in batches, so they are sorted by their timestamp before being
+ * returned.
+ * \throws std::runtime_error when the file cannot be read, or is not a trace of the current version.
+ */
+inline std::vector<trace_event_t> read_trace(char const* path) {
+	std::unique_ptr<std::FILE, int (*)(std::FILE*)> file {std::fopen(path, "rb"), &std::fclose};
+	PSL_EXCEPT_IF(!file, std::runtime_error, "could not open the trace file");
+
+	trace_header_t header {};
+	PSL_EXCEPT_IF(std::fread(&header, sizeof(header), 1, file.get()) != 1 ||
+					std::memcmp(header.magic, trace_header_t::magic_value, sizeof(header.magic)) != 0,
+				  std::runtime_error,
+				  "the file is not a psl trace");
+	PSL_EXCEPT_IF(header.version != trace_header_t::current_version || header.event_size != sizeof(trace_event_t),
+				  std::runtime_error,
+				  "the trace was written by an incompatible version");
+
+	std::vector<trace_event_t> events {};
+	std::array<trace_event_t, 1024> chunk;
+	while(auto count = std::fread(chunk.data(), sizeof(trace_event_t), chunk.size(), file.get()))
+		events.insert(events.end(), chunk.begin(), chunk.begin() + count);
+
+	std::stable_sort(events.begin(), events.end(), [](auto const& lhs, auto const& rhs) {
+		return lhs.timestamp < rhs.timestamp;
+	});
+	return events;
+}
+
+/**
+ * \brief Memory resource wrapper that records every allocation and deallocation into a trace file.
+ * \details Every operation is forwarded to the upstream resource, and recorded (size, alignment, timestamp and thread)
+ * into a ring buffer owned by the calling thread, without taking a lock. A full ring buffer is written to the file by
+ * the thread that fills it, the remainder is written by `flush()`, when the thread exits, or when the resource is
+ * destroyed. The file can be read back with `read_trace`, and replayed against other resources with the
+ * `psl_trace_replay` tool.
+ * \warning The upstream resource is used concurrently when the resource is, and so has to be thread-safe in that case.
+ *
+ * \tparam Upstream resource type that services the allocations.
+ */
+template <IsMemoryResource Upstream = config::default_memory_resource_t>
+class trace_resource
+	: public psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<true>, psl::traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+  public:
+	using upstream_type = Upstream;
+
+	inline constexpr static size_t buffer_size {4096};
+
+  private:
+	struct buffer_t {
+		std::uint16_t thread {0};
+		std::atomic<size_t> head {0};	 // only advanced by the owning thread.
+		std::atomic<size_t> tail {0};	 // only advanced while holding the file lock.
+		std::array<trace_event_t, buffer_size> events;
+	};
+
+	using registry_type = _priv::thread_registry<trace_resource, buffer_t>;
+	friend registry_type;
+
+  public:
+	/**
+	 * \param[in] alignment minimum alignment of every allocation.
+	 * \param[in] path file to write the trace to, it is truncated when it exists.
+	 * \param[in] upstream resource that services the allocations.
+	 */
+	trace_resource(size_t alignment, char const* path, Upstream* upstream = &psl::default_memory_resource)
+		: base_type(alignment), m_Upstream(upstream), m_Start(std::chrono::steady_clock::now()),
+		  m_File(std::fopen(path, "wb")), m_Registry(*this) {
+		PSL_EXCEPT_IF(!m_File, std::runtime_error, "could not open the trace file for writing");
+		trace_header_t header {};
+		std::memcpy(header.magic, trace_header_t::magic_value, sizeof(header.magic));
+		header.version	  = trace_header_t::current_version;
+		header.event_size = sizeof(trace_event_t);
+		std::fwrite(&header, sizeof(header), 1, m_File);
+	}
+
+	~trace_resource() {
+		m_Registry.release([this](buffer_t& buffer) {
+			std::lock_guard guard {m_FileLock};
+			drain(buffer);
+		});
+		std::fclose(m_File);
+	}
+
+	trace_resource(trace_resource const&)			 = delete;
+	trace_resource(trace_resource&&)				 = delete;
+	trace_resource& operator=(trace_resource const&) = delete;
+	trace_resource& operator=(trace_resource&&)		 = delete;
+
+	upstream_type* upstream() const noexcept { return m_Upstream; }
+
+	/**
+	 * \returns the amount of events recorded so far.
+	 */
+	size_t recorded() const noexcept { return m_Recorded.load(std::memory_order_relaxed); }
+
+	/**
+	 * \brief Writes the events that are still buffered by every thread to the file.
+	 */
+	void flush() {
+		std::lock_guard guard {m_FileLock};
+		m_Registry.for_each([this](buffer_t& buffer) { drain(buffer); });
+		std::fflush(m_File);
+	}
+
+  private:
+	buffer_t& local_buffer() {
+		return m_Registry.local([this](buffer_t& buffer) {
+			std::lock_guard guard {m_FileLock};
+			buffer.thread = m_NextThread++;
+		});
+	}
+
+	void record(trace_operation operation, void* address, size_t size, size_t alignment) {
+		auto& buffer = local_buffer();
+		auto head	 = buffer.head.load(std::memory_order_relaxed);
+		if(head - buffer.tail.load(std::memory_order_acquire) == buffer_size) {
+			std::lock_guard guard {m_FileLock};
+			drain(buffer);
+		}
+
+		auto& event		= buffer.events[head % buffer_size];
+		event.timestamp = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+							std::chrono::steady_clock::now() - m_Start)
+							.count();
+		event.address	= (std::uint64_t)(std::uintptr_t)address;
+		event.size		= size;
+		event.alignment = (std::uint32_t)alignment;
+		event.thread	= buffer.thread;
+		event.operation = operation;
+		event.reserved	= 0;
+		buffer.head.store(head + 1, std::memory_order_release);
+		m_Recorded.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Writes the buffered events of `buffer` to the file.
+	 * \note called with the file lock held.
+	 */
+	void drain(buffer_t& buffer) {
+		auto head = buffer.head.load(std::memory_order_acquire);
+		auto tail = buffer.tail.load(std::memory_order_relaxed);
+		while(tail != head) {
+			auto begin = tail % buffer_size;
+			auto count = std::min(head - tail, buffer_size - begin);
+			std::fwrite(&buffer.events[begin], sizeof(trace_event_t), count, m_File);
+			tail += count;
+		}
+		buffer.tail.store(tail, std::memory_order_release);
+	}
+
+	/**
+	 * \brief Writes the remaining events of an exiting thread.
+	 */
+	void retire(buffer_t& buffer) {
+		std::lock_guard guard {m_FileLock};
+		drain(buffer);
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		auto res   = m_Upstream->allocate(psl::align_to<size_t>(size, this->alignment()), align);
+		record((res) ? trace_operation::allocate : trace_operation::failed_allocate, res.data, size, align);
+		return res;
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		auto align = std::lcm(alignment, this->alignment());
+		if(ptr)
+			record(trace_operation::deallocate, ptr, size, align);
+		return m_Upstream->deallocate(ptr, psl::align_to<size_t>(size, this->alignment()), align);
+	}
+
+	Upstream* m_Upstream {nullptr};
+	std::chrono::steady_clock::time_point m_Start {};
+	std::FILE* m_File {nullptr};
+	std::atomic<size_t> m_Recorded {0};
+	std::mutex m_FileLock {};	 // guards the file and `m_NextThread`.
+	std::uint16_t m_NextThread {0};
+	registry_type m_Registry;
+};
+}	 // namespace psl
@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <psl/algorithms.hpp>
+#include <psl/allocator.hpp>
+#include <psl/details/virtual_memory.hpp>
+
+namespace psl {
+/**
+ * \brief Memory resource that reserves a large range of address space up front, and commits pages on demand.
+ * \details Allocations are stacked in the reserved range, each one starting on a page boundary and spanning whole
+ * pages. The most recent allocation can be resized in place by `reallocate` for as long as the reservation allows,
+ * only the pages it grows into are committed, and the pages it shrinks out of are decommitted. This means a container
+ * backed by this resource never has to move its elements, and its addresses remain stable while it grows.
+ * Deallocating the most recent allocation decommits its pages, other allocations are only reclaimed by `reset`.
+ * \note This resource is intended to back a single growing container (such as a `psl::array`), and is not
+ * synchronized.
+ */
+class virtual_memory_resource : public psl::traited_memory_resource<psl::traits::shareable_t<false>,
+																	 psl::traits::basic_allocation,
+																	 psl::traits::reallocate_able_t> {
+	using base_type = psl::traited_memory_resource<psl::traits::shareable_t<false>,
+												   psl::traits::basic_allocation,
+												   psl::traits::reallocate_able_t>;
+	friend struct _priv::resource_access;
+
+  public:
+	/**
+	 * \param[in] alignment minimum alignment of every allocation, cannot be larger than the page size.
+	 * \param[in] capacity amount of address space to reserve, this gets rounded up to the page size.
+	 */
+	virtual_memory_resource(size_t alignment, size_t capacity)
+		: base_type(alignment), m_PageSize(_priv::virtual_memory::page_size()),
+		  m_Capacity(psl::align_to(std::max<size_t>(capacity, 1), m_PageSize)) {
+		PSL_EXCEPT_IF(m_PageSize % alignment != 0,
+					  std::runtime_error,
+					  "virtual_memory_resource alignment cannot exceed the page size");
+		m_Begin = (std::byte*)_priv::virtual_memory::reserve(m_Capacity);
+		PSL_EXCEPT_IF(!m_Begin, std::runtime_error, "could not reserve the virtual_memory_resource range");
+		m_Top = m_Begin;
+	}
+
+	~virtual_memory_resource() { _priv::virtual_memory::release(m_Begin, m_Capacity); }
+
+	virtual_memory_resource(virtual_memory_resource const&)			   = delete;
+	virtual_memory_resource(virtual_memory_resource&&)				   = delete;
+	virtual_memory_resource& operator=(virtual_memory_resource const&) = delete;
+	virtual_memory_resource& operator=(virtual_memory_resource&&)	   = delete;
+
+	size_t page_size() const noexcept { return m_PageSize; }
+	size_t capacity() const noexcept { return m_Capacity; }
+
+	/**
+	 * \returns the amount of bytes currently committed.
+	 */
+	size_t committed() const noexcept { return (size_t)(m_Top - m_Begin); }
+
+	/**
+	 * \brief Decommits everything, invalidating all allocations.
+	 */
+	void reset() noexcept {
+		resize(m_Begin);
+		m_Last = nullptr;
+	}
+
+	/**
+	 * \brief Resizes the block at `location` to fit `count` items of `size` bytes.
+	 * \details The most recent allocation is always resized in place (when the reservation allows it), any other
+	 * allocation gets a new block instead, in which case `location` remains allocated.
+	 */
+	alloc_results<void> reallocate(void* location, size_t size, size_t count, size_t alignment) override {
+		auto bytes = size * count;
+		if(!location || location != m_Last)
+			return this->allocate(bytes, alignment);
+
+		auto* end = m_Last + psl::align_to(std::max<size_t>(bytes, 1), m_PageSize);
+		if(end > m_Begin + m_Capacity || !resize(end))
+			return {};
+		return make_result(m_Last, bytes, std::lcm(alignment, this->alignment()));
+	}
+
+  private:
+	/**
+	 * \brief Moves the top of the stack to `end`, committing or decommitting the pages in between.
+	 */
+	bool resize(std::byte* end) noexcept {
+		if(end > m_Top && !_priv::virtual_memory::commit(m_Top, (size_t)(end - m_Top)))
+			return false;
+		if(end < m_Top)
+			_priv::virtual_memory::decommit(end, (size_t)(m_Top - end));
+		m_Top = end;
+		return true;
+	}
+
+	alloc_results<void> make_result(std::byte* location, size_t size, size_t alignment) const noexcept {
+		alloc_results<void> result {};
+		result.data	  = location;
+		result.head	  = location;
+		result.tail	  = m_Top;
+		result.stride = psl::align_to<size_t>(size, alignment);
+		return result;
+	}
+
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		auto align	   = std::lcm(alignment, this->alignment());
+		auto* location = (std::byte*)psl::align_to<std::uintptr_t>((std::uintptr_t)m_Top, std::max(align, m_PageSize));
+		auto bytes	   = psl::align_to(std::max<size_t>(size, 1), m_PageSize);
+		if(location < m_Top || location + bytes > m_Begin + m_Capacity || !resize(location + bytes))
+			return {};
+		m_Last = location;
+		return make_result(location, size, align);
+	}
+
+	bool do_deallocate(void* ptr, [[maybe_unused]] size_t size, [[maybe_unused]] size_t alignment) override {
+		// the most recent allocation is given back, everything else is reclaimed by `reset`.
+		if(ptr && ptr == m_Last) {
+			resize(m_Last);
+			m_Last = nullptr;
+		}
+		return true;
+	}
+
+	size_t m_PageSize {0};
+	size_t m_Capacity {0};
+	std::byte* m_Begin {nullptr};
+	std::byte* m_Top {nullptr};
+	std::byte* m_Last {nullptr};
+};
+}	 // namespace psl
@@ -0,0 +1,43 @@
+#include <psl/details/heap.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(_WIN32)
+	#include <malloc.h>
+#elif defined(__APPLE__)
+	#include <malloc/malloc.h>
+#elif defined(__linux__)
+	#include <malloc.h>
+#endif
+
+namespace psl::_priv::heap {
+#if defined(_WIN32)
+void* allocate(size_t size, size_t alignment) noexcept { return _aligned_malloc(size, alignment); }
+
+void deallocate(void* address, size_t) noexcept { _aligned_free(address); }
+
+size_t usable_size(void* address, size_t, size_t alignment) noexcept { return _aligned_msize(address, alignment, 0); }
+#else
+void* allocate(size_t size, size_t alignment) noexcept {
+	if(alignment <= alignof(std::max_align_t))
+		return std::malloc(size);
+	void* result {nullptr};
+	if(posix_memalign(&result, std::max(alignment, sizeof(void*)), size) != 0)
+		return nullptr;
+	return result;
+}
+
+void deallocate(void* address, size_t) noexcept { std::free(address); }
+
+size_t usable_size([[maybe_unused]] void* address, size_t size, size_t) noexcept {
+	#if defined(__APPLE__)
+	return std::max(malloc_size(address), size);
+	#elif defined(__linux__)
+	return std::max(malloc_usable_size(address), size);
+	#else
+	return size;
+	#endif
+}
+#endif
+}	 // namespace psl::_priv::heap
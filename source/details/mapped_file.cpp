@@ -0,0 +1,170 @@
+#include <psl/details/mapped_file.hpp>
+#include <psl/details/virtual_memory.hpp>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace psl::_priv::mapped_file {
+#if defined(_WIN32)
+bool exists(char const* path) noexcept { return GetFileAttributesA(path) != INVALID_FILE_ATTRIBUTES; }
+
+bool map(mapping_t& result, char const* path, size_t size) noexcept {
+	auto file = CreateFileA(path,
+							GENERIC_READ | GENERIC_WRITE,
+							FILE_SHARE_READ | FILE_SHARE_WRITE,
+							nullptr,
+							(size != 0) ? CREATE_ALWAYS : OPEN_EXISTING,
+							FILE_ATTRIBUTE_NORMAL,
+							nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER file_size {};
+	if(size != 0) {
+		file_size.QuadPart = (LONGLONG)size;
+		if(!SetFilePointerEx(file, file_size, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+			CloseHandle(file);
+			return false;
+		}
+	} else if(!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	auto mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+	if(!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+	auto* address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+	if(!address) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	result = {address, (size_t)file_size.QuadPart, (std::intptr_t)file, (std::intptr_t)mapping};
+	return true;
+}
+
+bool map_shared(mapping_t& result, char const* name, size_t size) noexcept {
+	// kernel object names cannot contain a backslash, but the portable leading slash is harmless to skip.
+	if(name[0] == '/')
+		++name;
+	HANDLE mapping {nullptr};
+	if(size != 0) {
+		mapping = CreateFileMappingA(INVALID_HANDLE_VALUE,
+									 nullptr,
+									 PAGE_READWRITE,
+									 (DWORD)((std::uint64_t)size >> 32),
+									 (DWORD)((std::uint64_t)size & 0xFFFFFFFF),
+									 name);
+		if(mapping && GetLastError() == ERROR_ALREADY_EXISTS) {
+			CloseHandle(mapping);
+			return false;
+		}
+	} else
+		mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+	if(!mapping)
+		return false;
+
+	auto* address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+	if(!address) {
+		CloseHandle(mapping);
+		return false;
+	}
+	if(size == 0) {
+		MEMORY_BASIC_INFORMATION info {};
+		VirtualQuery(address, &info, sizeof(info));
+		size = info.RegionSize;
+	}
+	result = {address, size, -1, (std::intptr_t)mapping};
+	return true;
+}
+
+bool remove_shared(char const*) noexcept { return true; }
+
+bool flush(mapping_t const& mapping, void* address, size_t size) noexcept {
+	return FlushViewOfFile(address, size) != 0 && FlushFileBuffers((HANDLE)mapping.file) != 0;
+}
+
+void unmap(mapping_t& mapping) noexcept {
+	if(mapping.address)
+		UnmapViewOfFile(mapping.address);
+	if(mapping.mapping)
+		CloseHandle((HANDLE)mapping.mapping);
+	if(mapping.file != -1)
+		CloseHandle((HANDLE)mapping.file);
+	mapping = {};
+}
+#else
+bool exists(char const* path) noexcept {
+	struct stat info {};
+	return stat(path, &info) == 0;
+}
+
+namespace {
+/**
+ * \brief Maps the open descriptor `file`, resizing it first when `size` is non-zero, and takes ownership of it.
+ */
+bool map_descriptor(mapping_t& result, int file, size_t size) noexcept {
+	if(file == -1)
+		return false;
+
+	if(size != 0) {
+		if(ftruncate(file, (off_t)size) != 0) {
+			::close(file);
+			return false;
+		}
+	} else {
+		struct stat info {};
+		if(fstat(file, &info) != 0 || info.st_size == 0) {
+			::close(file);
+			return false;
+		}
+		size = (size_t)info.st_size;
+	}
+
+	auto* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	if(address == MAP_FAILED) {
+		::close(file);
+		return false;
+	}
+	result = {address, size, (std::intptr_t)file, 0};
+	return true;
+}
+}	 // namespace
+
+bool map(mapping_t& result, char const* path, size_t size) noexcept {
+	return map_descriptor(result, ::open(path, (size != 0) ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0644), size);
+}
+
+bool map_shared(mapping_t& result, char const* name, size_t size) noexcept {
+	return map_descriptor(result, shm_open(name, (size != 0) ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600), size);
+}
+
+bool remove_shared(char const* name) noexcept { return shm_unlink(name) == 0; }
+
+bool flush(mapping_t const& mapping, void* address, size_t size) noexcept {
+	// msync requires a page aligned start.
+	auto page	= (std::uintptr_t)virtual_memory::page_size();
+	auto offset = (std::uintptr_t)address % page;
+	return msync((char*)address - offset, size + offset, MS_SYNC) == 0 && fsync((int)mapping.file) == 0;
+}
+
+void unmap(mapping_t& mapping) noexcept {
+	if(mapping.address)
+		munmap(mapping.address, mapping.size);
+	if(mapping.file != -1)
+		::close((int)mapping.file);
+	mapping = {};
+}
+#endif
+}	 // namespace psl::_priv::mapped_file
@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <psl/details/virtual_memory.hpp>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace psl::_priv::virtual_memory {
+#if defined(_WIN32)
+size_t page_size() noexcept {
+	static size_t const size = [] {
+		SYSTEM_INFO info {};
+		GetSystemInfo(&info);
+		return (size_t)info.dwPageSize;
+	}();
+	return size;
+}
+
+void* reserve(size_t size) noexcept { return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS); }
+
+bool commit(void* address, size_t size) noexcept {
+	return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+bool decommit(void* address, size_t size) noexcept { return VirtualFree(address, size, MEM_DECOMMIT) != 0; }
+
+bool release(void* address, [[maybe_unused]] size_t size) noexcept {
+	return VirtualFree(address, 0, MEM_RELEASE) != 0;
+}
+
+size_t huge_page_size() noexcept {
+	static size_t const size = [] {
+		auto large = (size_t)GetLargePageMinimum();
+		return (large != 0) ? large : size_t {2} << 20;
+	}();
+	return size;
+}
+
+void* map_huge(size_t size, bool& huge) noexcept {
+	// large pages require the SeLockMemoryPrivilege, without it this fails and we fall back to normal pages.
+	huge = true;
+	if(auto* address = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+		return address;
+
+	huge = false;
+	// over-reserve to find a suitably aligned range, and then commit only that range.
+	auto* range = (char*)VirtualAlloc(nullptr, size + huge_page_size(), MEM_RESERVE, PAGE_NOACCESS);
+	if(!range)
+		return nullptr;
+	auto offset = (huge_page_size() - (size_t)((std::uintptr_t)range % huge_page_size())) % huge_page_size();
+	VirtualFree(range, 0, MEM_RELEASE);
+	return VirtualAlloc(range + offset, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+#else
+size_t page_size() noexcept {
+	static size_t const size = (size_t)sysconf(_SC_PAGESIZE);
+	return size;
+}
+
+void* reserve(size_t size) noexcept {
+	auto* address = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	return (address == MAP_FAILED) ? nullptr : address;
+}
+
+bool commit(void* address, size_t size) noexcept { return mprotect(address, size, PROT_READ | PROT_WRITE) == 0; }
+
+bool decommit(void* address, size_t size) noexcept {
+	return madvise(address, size, MADV_DONTNEED) == 0 && mprotect(address, size, PROT_NONE) == 0;
+}
+
+bool release(void* address, size_t size) noexcept { return munmap(address, size) == 0; }
+
+size_t huge_page_size() noexcept { return size_t {2} << 20; }
+
+void* map_huge(size_t size, bool& huge) noexcept {
+	huge = true;
+	#if defined(MAP_HUGETLB)
+	if(auto* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	   address != MAP_FAILED)
+		return address;
+	#endif
+
+	// over-map so the range can be trimmed to a huge page aligned one, transparent huge pages require the alignment.
+	auto alignment = huge_page_size();
+	auto* range = (char*)mmap(nullptr, size + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(range == MAP_FAILED)
+		return nullptr;
+	auto offset = (alignment - (size_t)((std::uintptr_t)range % alignment)) % alignment;
+	if(offset != 0)
+		munmap(range, offset);
+	munmap(range + offset + size, alignment - offset);
+
+	#if defined(MADV_HUGEPAGE)
+	huge = madvise(range + offset, size, MADV_HUGEPAGE) == 0;
+	#else
+	huge = false;
+	#endif
+	return range + offset;
+}
+#endif
+}	 // namespace psl::_priv::virtual_memory
@@ -0,0 +1,145 @@
+#include <array>
+#include <psl/allocation_statistics.hpp>
+#include <psl/allocator.hpp>
+#include <psl/array.hpp>
+#include <thread>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+namespace {
+/**
+ * \brief forwards to a `new_resource`, but fails allocations that are larger than the limit.
+ */
+class limited_resource final : public traited_memory_resource<traits::shareable_t<true>,
+															  traits::basic_allocation,
+															  traits::allocation_statistics_t> {
+	using base_type =
+	  traited_memory_resource<traits::shareable_t<true>, traits::basic_allocation, traits::allocation_statistics_t>;
+	friend struct _priv::resource_access;
+
+  public:
+	limited_resource(size_t alignment, size_t limit) : base_type(alignment), m_Limit(limit) {}
+
+  private:
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		if(size > m_Limit)
+			return {};
+		return m_Upstream.allocate(psl::align_to<size_t>(size, this->alignment()), alignment);
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		return m_Upstream.deallocate(ptr, psl::align_to<size_t>(size, this->alignment()), alignment);
+	}
+
+	new_resource m_Upstream {1};
+	size_t m_Limit {0};
+};
+
+using statistics_allocator_t =
+  psl::allocator<traits::shareable_t<true>, traits::basic_allocation, traits::allocation_statistics_t>;
+}	 // namespace
+
+auto allocation_statistics_test0 = suite<"allocation_statistics", "psl", "psl::memory">() = [] {
+	static_assert(traits::allocation_statistics_t::histogram_index(0) == 0);
+	static_assert(traits::allocation_statistics_t::histogram_index(1) == 0);
+	static_assert(traits::allocation_statistics_t::histogram_index(2) == 1);
+	static_assert(traits::allocation_statistics_t::histogram_index(4) == 2);
+	static_assert(traits::allocation_statistics_t::histogram_index(5) == 3);
+	static_assert(traits::allocation_statistics_t::histogram_index(~size_t {0}) ==
+				  traits::allocation_statistics_t::histogram_size - 1);
+	static_assert(traits::HasTrait<statistics_allocator_t, traits::allocation_statistics_t>);
+	static_assert(!traits::HasTrait<new_resource, traits::allocation_statistics_t>);
+
+	limited_resource resource {alignof(int), 1024};
+
+	section<"allocator">() = [&] {
+		statistics_allocator_t allocator {&resource};
+		auto first	= allocator.allocate<int>();
+		auto second = allocator.allocate<int>();
+		auto large	= allocator.allocate_n<int>(100);
+
+		auto stats = resource.snapshot();
+		expect(stats.allocations) == 3u;
+		expect(stats.live_bytes) == 2 * sizeof(int) + 100 * sizeof(int);
+		expect(stats.histogram[traits::allocation_statistics_t::histogram_index(sizeof(int))]) == 2u;
+		expect(stats.histogram[traits::allocation_statistics_t::histogram_index(100 * sizeof(int))]) == 1u;
+
+		allocator.deallocate(large.data, 100 * sizeof(int));
+		allocator.deallocate(first.data);
+		stats = resource.snapshot();
+		expect(stats.deallocations) == 2u;
+		expect(stats.live_bytes) == sizeof(int);
+		expect(stats.peak_bytes) == 2 * sizeof(int) + 100 * sizeof(int);
+
+		expect((bool)allocator.allocate_n<int>(1024)) == false;
+		expect(resource.snapshot().failed_allocations) == 1u;
+		expect(resource.snapshot().allocations) == 3u;
+		allocator.deallocate(second.data);
+		expect(resource.snapshot().live_bytes) == 0u;
+	};
+
+	section<"batch">() = [&] {
+		statistics_allocator_t allocator {&resource};
+		std::array<int*, 16> items {};
+		expect(allocator.allocate_batch(items.data(), items.size())) == items.size();
+		expect(resource.snapshot().allocations) == items.size();
+		expect(resource.snapshot().live_bytes) == items.size() * sizeof(int);
+		allocator.deallocate_batch(items.data(), items.size());
+		expect(resource.snapshot().deallocations) == items.size();
+		expect(resource.snapshot().live_bytes) == 0u;
+	};
+
+	section<"bound_allocator">() = [&] {
+		bound_allocator<limited_resource> allocator {&resource};
+		{
+			psl::array<int, psl::dynamic_extent, settings::array<bound_allocator<limited_resource>>> arr {allocator};
+			for(int i = 0; i < 64; ++i) arr.emplace_back(i);
+			expect(resource.snapshot().allocations > 0u) == true;
+			expect(resource.snapshot().live_bytes >= 64 * sizeof(int)) == true;
+		}
+		expect(resource.snapshot().live_bytes) == 0u;
+	};
+
+	section<"construct and destroy">() = [&] {
+		limited_resource aligned {8, 1024};
+		statistics_allocator_t allocator {&aligned};
+		for(int i = 0; i < 1000; ++i) {
+			auto value = psl::construct<int>(allocator, i);
+			expect(*value.data) == i;
+			psl::destroy(allocator, *value.data);
+		}
+		auto stats = aligned.snapshot();
+		expect(stats.allocations) == 1000u;
+		expect(stats.deallocations) == 1000u;
+		expect(stats.live_bytes) == 0u;
+		expect(stats.peak_bytes) == 8u;
+	};
+
+	section<"concurrent">() = [&] {
+		constexpr size_t threads	 = 4;
+		constexpr size_t iterations = 10000;
+		std::vector<std::thread> workers {};
+		for(size_t i = 0; i < threads; ++i) {
+			workers.emplace_back([&] {
+				statistics_allocator_t allocator {&resource};
+				for(size_t iteration = 0; iteration < iterations; ++iteration) {
+					auto res = allocator.allocate<std::uint64_t>();
+					allocator.deallocate(res.data);
+				}
+			});
+		}
+		for(auto& worker : workers) worker.join();
+
+		auto stats = resource.snapshot();
+		expect(stats.allocations) == threads * iterations;
+		expect(stats.deallocations) == threads * iterations;
+		expect(stats.live_bytes) == 0u;
+		expect(stats.peak_bytes >= sizeof(std::uint64_t)) == true;
+	};
+};
@@ -1,6 +1,8 @@
 #include <array>
 #include <psl/allocator.hpp>
+#include <psl/array.hpp>
 #include <psl/span.hpp>
+#include <vector>
 
 #include <litmus/expect.hpp>
 #include <litmus/section.hpp>
@@ -11,7 +13,12 @@ using namespace psl;
 using namespace litmus;
 
 auto allocator_test0 =
-  suite<"allocator", "psl">().templates<tpack<int>, tpack<config::default_allocator_t>, tpack<new_resource>>() =
+  suite<"allocator", "psl">()
+	.templates<tpack<int>,
+			   tpack<config::default_allocator_t,
+					 bound_allocator<new_resource>,
+					 bound_allocator<new_resource, alignof(int)>>,
+			   tpack<new_resource>>() =
 	[]<typename T, typename Allocator, typename MemoryResource>() {
 		MemoryResource* memory_resource = new MemoryResource(alignof(int));
 		Allocator allocator {memory_resource};
@@ -34,4 +41,70 @@ auto allocator_test0 =
 			++i;
 			expect(it) == i;
 		}
+
+		std::array<T*, 16> batch {};
+		expect(allocator.allocate_batch(batch.data(), batch.size())) == batch.size();
+		for(T i = T {0}; auto* it : batch) *it = i++;
+		for(T i = T {0}; auto* it : batch) expect(*it) == i++;
+		expect(allocator.deallocate_batch(batch.data(), batch.size())) == true;
+	};
+
+auto allocator_test1 = suite<"bound_allocator", "psl">() = [] {
+	using bound_t = bound_allocator<new_resource, alignof(int)>;
+	static_assert(traits::HasTrait<bound_t, traits::basic_allocation>);
+	static_assert(traits::IsShareable<bound_t>);
+	static_assert(!traits::IsReallocateAble<bound_t>);
+
+	new_resource resource {alignof(int)};
+	bound_t allocator {&resource};
+	psl::array<int, psl::dynamic_extent, settings::array<bound_t>> arr {allocator};
+	for(int i = 0; i < 1024; ++i) arr.emplace_back(i);
+	for(int i = 0; i < 1024; ++i) expect(arr[i]) == i;
+
+	new_resource misaligned {alignof(double) * 2};
+	expect([&] { bound_t {&misaligned}; }) == throws<>();
+};
+
+auto allocator_test2 = suite<"malloc_resource", "psl">() = [] {
+	static_assert(traits::IsSizeQueryable<malloc_resource>);
+	malloc_resource resource {alignof(int)};
+
+	auto res = resource.allocate(100, 64);
+	expect((bool)res) == true;
+	expect((std::uintptr_t)res.data % 64) == 0u;
+	expect(res.tail - (std::byte*)res.data >= 100) == true;
+	expect(resource.size()) == (size_t)(res.tail - (std::byte*)res.data);
+	expect(resource.deallocate(res.data, 100, 64)) == true;
+	expect(resource.size()) == 0u;
+
+	// the array's capacity covers the whole block, including the slack the heap added.
+	using allocator_t = allocator<traits::shareable_t<true>, traits::basic_allocation, traits::queryable_size_t>;
+	psl::array<int, psl::dynamic_extent, settings::array<allocator_t, default_t, 0>> arr {allocator_t {&resource}};
+	arr.reserve(3);
+	expect(arr.capacity() * sizeof(int)) == resource.size();
+	for(int i = 0; i < 1024; ++i) arr.emplace_back(i);
+	for(int i = 0; i < 1024; ++i) expect(arr[i]) == i;
+	expect(arr.capacity() * sizeof(int) <= resource.size()) == true;
+	arr.clear();
+	arr.shrink_to_fit();
+	expect(resource.size()) == 0u;
+
+	section<"reported sizes stay aligned">() = [] {
+		for(size_t alignment : {16u, 64u}) {
+			malloc_resource aligned {alignment};
+			std::vector<alloc_results<void>> blocks {};
+			size_t total {0};
+			for(size_t size = 1; size <= 1024; size += 13) {
+				auto block = aligned.allocate(size, alignment);
+				expect((bool)block) == true;
+				expect((std::uintptr_t)block.tail % alignment) == 0u;
+				expect(block.size() >= size) == true;
+				total += block.size();
+				blocks.emplace_back(block);
+			}
+			expect(aligned.size()) == total;
+			for(auto& block : blocks) expect(aligned.deallocate(block.data, block.size(), alignment)) == true;
+			expect(aligned.size()) == 0u;
+		}
 	};
+};
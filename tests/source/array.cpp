@@ -1,4 +1,5 @@
 #include <psl/array.hpp>
+#include <psl/memory/budget_resource.hpp>
 #include <tests/types.hpp>
 
 #include <litmus/expect.hpp>
@@ -218,3 +219,129 @@ auto array_test2 =
 			};
 		};
 	};
+
+auto array_test3 = suite<"scoped_allocator", "psl", "psl::array", "containers">() = [] {
+	using allocator_t = allocator<traits::shareable_t<true>, traits::basic_allocation, traits::queryable_size_t>;
+	using settings_t =
+	  settings::array<allocator_t, default_t, settings::default_sbo_size, sbo_alias<false>, scoped_allocator<true>>;
+	using inner_t = psl::array<int, psl::dynamic_extent, settings_t>;
+	using outer_t = psl::array<inner_t, psl::dynamic_extent, settings_t>;
+
+	budget_resource<> resource {alignof(int), size_t {1} << 20};
+	allocator_t allocator {&resource};
+
+	section<"elements receive the allocator">() = [&] {
+		{
+			outer_t outer {allocator};
+			for(int i = 0; i < 32; ++i) {
+				auto& inner = outer.emplace_back();
+				for(int j = 0; j < 64; ++j) inner.emplace_back(i * j);
+			}
+			outer.resize(40);
+			outer.resize(48, outer[1]);
+
+			for(auto& inner : outer) {
+				auto inner_allocator = inner.get_allocator();
+				expect(inner_allocator.resource() == &resource) == true;
+			}
+			expect(outer[47][63]) == 63;
+			expect(resource.used()) > 48 * 64 * sizeof(int);
+
+			// copies stay in the allocator of the source, moves take over its storage.
+			outer_t copy {outer};
+			expect(copy[5][7]) == 35;
+			auto* storage = &copy[0][0];
+			outer_t moved {std::move(copy)};
+			expect(&moved[0][0]) == storage;
+			expect(copy.empty()) == true;
+		}
+		// the outer array destroys its elements, which return their storage.
+		expect(resource.used()) == 0u;
+	};
+
+	section<"assignment keeps the allocator">() = [&] {
+		budget_resource<> other_resource {alignof(int), size_t {1} << 20};
+		{
+			outer_t source {allocator_t {&other_resource}};
+			for(int i = 0; i < 8; ++i) {
+				auto& inner = source.emplace_back();
+				for(int j = 0; j < 64; ++j) inner.emplace_back(i * j);
+			}
+
+			outer_t target {allocator};
+			target.emplace_back().emplace_back(1);
+			auto used = other_resource.used();
+			target	  = source;
+			expect(target.get_allocator() == allocator) == true;
+			expect(target[0].get_allocator() == allocator) == true;
+			expect(target[7][63]) == 7 * 63;
+			expect(other_resource.used()) == used;
+
+			// the storage of another resource can't be taken over, the elements are moved one by one instead.
+			outer_t moved {allocator};
+			moved = std::move(source);
+			expect(moved.get_allocator() == allocator) == true;
+			expect(moved[7].get_allocator() == allocator) == true;
+			expect(moved[7][63]) == 7 * 63;
+			expect(source.empty()) == true;
+
+			// within the same resource the storage changes owner.
+			auto* storage = &moved[0][0];
+			target		  = std::move(moved);
+			expect(&target[0][0]) == storage;
+			expect(moved.empty()) == true;
+		}
+		expect(resource.used()) == 0u;
+		expect(other_resource.used()) == 0u;
+	};
+
+	section<"resize with one of its own elements">() = [&] {
+		{
+			outer_t outer {allocator};
+			outer.emplace_back().resize(64, 3);
+			for(size_t i = 1; i < 64; ++i) {
+				outer.resize(outer.size() + 1, outer[0]);
+				expect(outer.back().size()) == 64u;
+				expect(outer.back()[63]) == 3;
+			}
+		}
+		expect(resource.used()) == 0u;
+	};
+
+	section<"disabled by default">() = [&] {
+		using unscoped_t = psl::array<psl::array<int>, psl::dynamic_extent, settings::array<allocator_t>>;
+		static_assert(!settings::array<allocator_t>::propagate_allocator);
+		{
+			unscoped_t outer {allocator};
+			auto& inner = outer.emplace_back();
+			auto used	= resource.used();
+			for(int j = 0; j < 64; ++j) inner.emplace_back(j);
+			expect(inner.is_stored_inlined()) == false;
+			expect(resource.used()) == used;
+		}
+		expect(resource.used()) == 0u;
+	};
+
+	section<"shrinking destroys the dropped elements">() = [&] {
+		using inline_settings_t =
+		  settings::array<allocator_t, default_t, psl::bytes_t {1024}, sbo_alias<false>, scoped_allocator<true>>;
+		using inline_outer_t = psl::array<inner_t, psl::dynamic_extent, inline_settings_t>;
+		static_assert(std::is_nothrow_move_constructible_v<inline_outer_t>);
+		{
+			inline_outer_t outer {allocator};
+			outer.resize(4);
+			for(auto& inner : outer)
+				for(int j = 0; j < 64; ++j) inner.emplace_back(j);
+			expect(outer.is_stored_inlined()) == true;
+			auto used = resource.used();
+
+			outer.resize(1);
+			expect(outer.size()) == 1u;
+			expect(resource.used()) < used;
+			expect(outer[0][63]) == 63;
+			outer.resize(2, outer[0]);
+			expect(outer[1][63]) == 63;
+		}
+		expect(resource.used()) == 0u;
+	};
+};
@@ -0,0 +1,91 @@
+#include <psl/memory/bucketizer_resource.hpp>
+#include <psl/memory/buddy_resource.hpp>
+#include <psl/memory/monotonic_resource.hpp>
+#include <psl/memory/pool_resource.hpp>
+#include <psl/memory/segregator_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace psl;
+using namespace litmus;
+
+auto bucketizer_resource_test0 = suite<"bucketizer_resource", "psl", "psl::memory">() = [] {
+	bucketizer_resource<monotonic_resource<>, 1, 256, 64> resource {alignof(int), size_t {4096}};
+	static_assert(decltype(resource)::bucket_count == 4);
+	static_assert(!traits::IsShareable<decltype(resource)>);
+
+	section<"buckets">() = [&] {
+		expect(resource.bucket_index(1)) == 0u;
+		expect(resource.bucket_index(64)) == 0u;
+		expect(resource.bucket_index(65)) == 1u;
+		expect(resource.bucket_index(256)) == 3u;
+		expect(resource.bucket_index(0)) == resource.bucket_count;
+		expect(resource.bucket_index(257)) == resource.bucket_count;
+
+		// every bucket bumps through its own block.
+		auto first	= resource.allocate(10, alignof(int));
+		auto second = resource.allocate(100, alignof(int));
+		auto third	= resource.allocate(20, alignof(int));
+		expect((std::byte*)third.data - (std::byte*)first.data) == 12;
+		expect(second.size() <= 128u) == true;
+		expect(resource.allocate(300, alignof(int))) == false;
+		expect(resource.deallocate(third.data, 20, alignof(int))) == true;
+		expect(resource.deallocate(second.data, 100, alignof(int))) == true;
+		expect(resource.deallocate(first.data, 10, alignof(int))) == true;
+	};
+
+	section<"batch">() = [&] {
+		std::array<void*, 8> blocks {};
+		expect(resource.allocate_batch(200, alignof(int), blocks.size(), blocks.data())) == blocks.size();
+		expect(resource.deallocate_batch(blocks.data(), blocks.size(), 200, alignof(int))) == true;
+		expect(resource.allocate_batch(512, alignof(int), blocks.size(), blocks.data())) == 0u;
+	};
+};
+
+auto bucketizer_resource_test1 = suite<"bucketizer_resource", "psl", "psl::memory">() = [] {
+	// a full stack: small sizes are spread over buckets, everything else goes to the heap.
+	using buckets_t = bucketizer_resource<pool_resource<>, 1, 1024, 256>;
+	segregator_resource<1024, buckets_t, new_resource> resource {16};
+	static_assert(traits::IsShareable<decltype(resource)>);
+
+	section<"stack">() = [&] {
+		psl::allocator<traits::shareable_t<true>, traits::basic_allocation> allocator {&resource};
+		std::vector<std::pair<void*, size_t>> blocks {};
+		for(size_t size = 1; size < 4096; size += 97)
+			blocks.emplace_back(allocator.allocate<std::byte>(size).data, size);
+		for(auto [block, size] : blocks) expect(allocator.deallocate((std::byte*)block, size)) == true;
+	};
+};
+
+auto bucketizer_resource_test2 = suite<"bucketizer_resource", "psl", "psl::memory">() = [] {
+	section<"bucket ends are multiples of the alignment">() = [] {
+		// buddies forward the blocks they don't own to their upstream, so a misrouted deallocation is not hidden.
+		bucketizer_resource<buddy_resource<>, 16, 256, 16> resource {8, size_t {4096}, size_t {16}};
+		for(size_t size : {20u, 24u, 31u, 32u, 100u}) {
+			auto block = resource.allocate(size, 8);
+			expect((bool)block) == true;
+			expect(block.size() >= size && block.size() % 8 == 0) == true;
+			expect(resource.bucket_index(block.size())) == resource.bucket_index(psl::align_to<size_t>(size, 8));
+			expect(resource.deallocate(block.data, block.size(), 8)) == true;
+		}
+	};
+
+	section<"Min and Step are not multiples of the alignment">() = [] {
+		bucketizer_resource<pool_resource<>, 12, 252, 12> resource {8};
+		std::vector<alloc_results<void>> blocks {};
+		for(size_t size = 12; size <= 248; ++size) {
+			auto block = resource.allocate(size, 8);
+			expect((bool)block) == true;
+			expect(block.size() >= size && block.size() % 8 == 0) == true;
+			expect(resource.bucket_index(block.size())) == resource.bucket_index(psl::align_to<size_t>(size, 8));
+			blocks.emplace_back(block);
+		}
+		// the reported size routes to the same bucket as the requested one.
+		for(auto& block : blocks) expect(resource.deallocate(block.data, block.size(), 8)) == true;
+	};
+};
@@ -0,0 +1,91 @@
+#include <psl/array.hpp>
+#include <psl/memory/buddy_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+namespace {
+using buddy_allocator_t =
+  psl::allocator<traits::shareable_t<true>, traits::basic_allocation, traits::reallocate_able_t>;
+}
+
+auto buddy_resource_test0 = suite<"buddy_resource", "psl", "psl::memory">() = [] {
+	buddy_resource<> resource {alignof(int), 1 << 16, 64};
+	static_assert(traits::IsReallocateAble<buddy_resource<>>);
+	static_assert(traits::IsReallocateAble<buddy_allocator_t>);
+
+	section<"allocate">() = [&] {
+		expect(resource.capacity()) == size_t {1 << 16};
+		auto first = resource.allocate(100, 4);
+		expect((bool)first) == true;
+		expect(first.size()) == 128u;
+		auto second = resource.allocate(64, 64);
+		expect((std::uintptr_t)second.data % 64) == 0u;
+		expect(second.size()) == 64u;
+
+		resource.deallocate(first.data, 100, 4);
+		resource.deallocate(second.data, 64, 64);
+
+		// everything merged back into a single block
+		auto whole = resource.allocate(1 << 16, 4);
+		expect((bool)whole) == true;
+		expect(whole.size()) == size_t {1 << 16};
+		resource.deallocate(whole.data, 1 << 16, 4);
+	};
+
+	section<"reallocate in place">() = [&] {
+		auto block = resource.allocate(256, 4);
+		auto grown = resource.reallocate(block.data, 4, 256, 4);
+		expect(grown.data) == block.data;
+		expect(grown.size()) == 1024u;
+
+		auto shrunk = resource.reallocate(grown.data, 4, 16, 4);
+		expect(shrunk.data) == block.data;
+		expect(shrunk.size()) == 64u;
+
+		// the freed upper halves can be handed out again
+		auto other = resource.allocate(64, 4);
+		expect((std::byte*)other.data) == (std::byte*)block.data + 64;
+		resource.deallocate(other.data, 64, 4);
+		resource.deallocate(shrunk.data, 64, 4);
+	};
+
+	section<"reallocate relocates">() = [&] {
+		auto block	   = resource.allocate(64, 4);
+		auto neighbour = resource.allocate(64, 4);
+		expect((std::byte*)neighbour.data) == (std::byte*)block.data + 64;
+
+		auto grown = resource.reallocate(block.data, 1, 128, 4);
+		expect((bool)grown) == true;
+		expect(grown.data != block.data) == true;
+
+		resource.deallocate(block.data, 64, 4);
+		resource.deallocate(neighbour.data, 64, 4);
+		resource.deallocate(grown.data, 128, 4);
+	};
+
+	section<"overflow goes upstream">() = [&] {
+		auto res = resource.allocate(1 << 17, 4);
+		expect((bool)res) == true;
+		expect(resource.deallocate(res.data, 1 << 17, 4)) == true;
+	};
+
+	section<"array grows in place">() = [&] {
+		buddy_allocator_t allocator {&resource};
+		psl::array<int, psl::dynamic_extent, settings::array<buddy_allocator_t>> arr {allocator};
+		arr.reserve(128);
+		for(int i = 0; i < 128; ++i) arr.emplace_back(i);
+		auto* data = &arr[0];
+		arr.reserve(1024);
+		expect(&arr[0]) == data;
+		expect(arr.capacity()) == 1024u;
+		for(int i = 128; i < 1024; ++i) arr.emplace_back(i);
+		for(int i = 0; i < 1024; ++i) expect(arr[i]) == i;
+		arr.shrink_to_fit();
+		expect(&arr[0]) == data;
+	};
+};
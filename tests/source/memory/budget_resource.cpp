@@ -0,0 +1,164 @@
+#include <atomic>
+#include <psl/memory/budget_resource.hpp>
+#include <thread>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+auto budget_resource_test0 = suite<"budget_resource", "psl", "psl::memory">() = [] {
+	section<"budget">() = [] {
+		budget_resource<> resource {16, 1024};
+		expect(resource.size()) == 1024u;
+		expect(resource.pressure()) == memory_pressure::none;
+		expect([] { budget_resource<> invalid {16, 1024, 512, 256}; }) == throws<>();
+
+		auto first = resource.allocate(100, 16);
+		expect((bool)first) == true;
+		// allocations are charged their size rounded up to the alignment.
+		expect(resource.used()) == 112u;
+		expect((size_t)(first.tail - (std::byte*)first.data)) == 112u;
+
+		auto second = resource.allocate(1024 - 112, 16);
+		expect((bool)second) == true;
+		expect(resource.available()) == 0u;
+		expect((bool)resource.allocate(1, 16)) == false;
+		expect(resource.used()) == 1024u;
+
+		expect(resource.deallocate(second.data, 1024 - 112, 16)) == true;
+		expect(resource.deallocate(first.data, 100, 16)) == true;
+		expect(resource.used()) == 0u;
+		expect(resource.deallocate(nullptr, 0, 16)) == true;
+	};
+
+	section<"watermarks">() = [] {
+		budget_resource<> resource {16, 1024, 512, 768};
+		std::vector<memory_pressure> raised {};
+		auto handle = resource.add_pressure_callback([&](memory_pressure level) { raised.emplace_back(level); });
+
+		auto a = resource.allocate(256, 16);
+		expect(raised.empty()) == true;
+		auto b = resource.allocate(256, 16);
+		expect(raised.size()) == 1u;
+		expect(raised.back()) == memory_pressure::soft;
+		expect(resource.pressure()) == memory_pressure::soft;
+
+		// staying above a watermark does not raise it again.
+		auto c = resource.allocate(16, 16);
+		expect(raised.size()) == 1u;
+
+		// skipping past both watermarks raises the highest one.
+		expect(resource.deallocate(c.data, 16, 16)) == true;
+		expect(resource.deallocate(b.data, 256, 16)) == true;
+		auto d = resource.allocate(640, 16);
+		expect(raised.size()) == 2u;
+		expect(raised.back()) == memory_pressure::hard;
+
+		resource.remove_pressure_callback(handle);
+		expect(resource.deallocate(d.data, 640, 16)) == true;
+		auto e = resource.allocate(640, 16);
+		expect(raised.size()) == 2u;
+
+		expect(resource.deallocate(e.data, 640, 16)) == true;
+		expect(resource.deallocate(a.data, 256, 16)) == true;
+	};
+
+	section<"caches trim on hard pressure">() = [] {
+		budget_resource<> resource {16, 1024, 512, 768};
+		std::vector<alloc_results<void>> cache {};
+		size_t trims {0};
+		resource.add_pressure_callback([&](memory_pressure level) {
+			if(level != memory_pressure::hard)
+				return;
+			++trims;
+			while(resource.used() > 256 && !cache.empty()) {
+				resource.deallocate(cache.back().data, 128, 16);
+				cache.pop_back();
+			}
+		});
+
+		for(size_t i = 0; i < 5; ++i) cache.emplace_back(resource.allocate(128, 16));
+		expect(trims) == 0u;
+		// crossing the hard watermark already makes the cache trim.
+		cache.emplace_back(resource.allocate(128, 16));
+		expect(trims) == 1u;
+		expect(resource.used()) == 256u;
+
+		// an allocation that does not fit gets the cache to trim first, and then succeeds.
+		auto pinned = resource.allocate(384, 16);
+		expect(resource.used()) == 640u;
+		expect(trims) == 1u;
+		auto large = resource.allocate(512, 16);
+		expect((bool)large) == true;
+		expect(cache.empty()) == true;
+		expect(resource.used()) == 896u;
+
+		expect(resource.deallocate(pinned.data, 384, 16)) == true;
+		expect(resource.deallocate(large.data, 512, 16)) == true;
+		for(auto& block : cache) resource.deallocate(block.data, 128, 16);
+		expect(resource.used()) == 0u;
+	};
+
+	section<"nested budgets">() = [] {
+		budget_resource<> global {16, 1024, 1024, 1024};
+		budget_resource<budget_resource<>> subsystem {16, 768, 768, 768, &global};
+		size_t global_pressure {0};
+		global.add_pressure_callback([&](memory_pressure) { ++global_pressure; });
+
+		auto outside = global.allocate(512, 16);
+		auto inside	 = subsystem.allocate(256, 16);
+		expect((bool)inside) == true;
+		expect(subsystem.used()) == 256u;
+		expect(global.used()) == 768u;
+
+		// fits the subsystem's budget, but not the global one.
+		expect((bool)subsystem.allocate(512, 16)) == false;
+		expect(global_pressure) == 1u;
+		expect(subsystem.used()) == 256u;
+
+		expect(global.deallocate(outside.data, 512, 16)) == true;
+		auto more = subsystem.allocate(512, 16);
+		expect((bool)more) == true;
+		expect(global.used()) == 768u;
+		// the subsystem's own budget is exhausted first.
+		expect((bool)subsystem.allocate(16, 16)) == false;
+		expect(global_pressure) == 1u;
+
+		expect(subsystem.deallocate(more.data, 512, 16)) == true;
+		expect(subsystem.deallocate(inside.data, 256, 16)) == true;
+		expect(global.used()) == 0u;
+	};
+
+	section<"threads">() = [] {
+		constexpr size_t budget = 64 * 1024;
+		budget_resource<> resource {16, budget};
+		std::atomic<size_t> failures {0};
+		std::vector<std::thread> threads {};
+		for(size_t t = 0; t < 4; ++t) {
+			threads.emplace_back([&, t] {
+				std::vector<alloc_results<void>> blocks {};
+				for(size_t i = 0; i < 10000; ++i) {
+					auto size = 16 * (1 + (i + t) % 64);
+					if(auto block = resource.allocate(size, 16); block)
+						blocks.emplace_back(block);
+					if(resource.used() > budget)
+						++failures;
+					if(blocks.size() > 16 || (!blocks.empty() && i % 3 == 0)) {
+						auto& block = blocks.front();
+						resource.deallocate(block.data, (size_t)(block.tail - (std::byte*)block.data), 16);
+						blocks.erase(blocks.begin());
+					}
+				}
+				for(auto& block : blocks)
+					resource.deallocate(block.data, (size_t)(block.tail - (std::byte*)block.data), 16);
+			});
+		}
+		for(auto& thread : threads) thread.join();
+		expect(failures.load()) == 0u;
+		expect(resource.used()) == 0u;
+	};
+};
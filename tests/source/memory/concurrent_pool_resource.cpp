@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <mutex>
+#include <psl/memory/budget_resource.hpp>
+#include <psl/memory/concurrent_pool_resource.hpp>
+#include <thread>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+auto concurrent_pool_resource_test0 = suite<"concurrent_pool_resource", "psl", "psl::memory">() = [] {
+	concurrent_pool_resource<> resource {alignof(std::uint64_t), 48, 16};
+	static_assert(traits::IsShareable<concurrent_pool_resource<>>);
+
+	section<"blocks">() = [&] {
+		expect(resource.block_size()) == 48u;
+		auto first = resource.allocate(40, 8);
+		expect((bool)first) == true;
+		expect(first.size()) == 48u;
+		expect((std::uintptr_t)first.data % 8) == 0u;
+		expect(resource.capacity()) == 16u;
+
+		resource.deallocate(first.data, 40, 8);
+		auto second = resource.allocate(48, 8);
+		expect(second.data) == first.data;
+		resource.deallocate(second.data, 48, 8);
+	};
+
+	section<"growth">() = [&] {
+		std::vector<void*> blocks {};
+		for(int i = 0; i < 100; ++i) blocks.emplace_back(resource.allocate(48, 8).data);
+		std::sort(blocks.begin(), blocks.end());
+		expect(std::adjacent_find(blocks.begin(), blocks.end()) == blocks.end()) == true;
+		expect(resource.capacity() >= 100u) == true;
+		for(auto* block : blocks) resource.deallocate(block, 48, 8);
+	};
+
+	section<"oversized requests">() = [&] {
+		auto res = resource.allocate(256, 8);
+		expect((bool)res) == true;
+		expect(resource.deallocate(res.data, 256, 8)) == true;
+	};
+
+	section<"exhausted pool">() = [&] {
+		// fits the first two chunks (4 and 8 blocks of 16 bytes), but not the third.
+		budget_resource<> upstream {16, 256};
+		concurrent_pool_resource<budget_resource<>> pool {16, 16, 4, &upstream};
+		std::vector<void*> blocks {};
+		for(int i = 0; i < 12; ++i) blocks.emplace_back(pool.allocate(16, 16).data);
+		expect(upstream.used()) == 192u;
+
+		auto overflow = pool.allocate(16, 16);
+		expect((bool)overflow) == true;
+		expect(pool.capacity()) == 12u;
+		expect(upstream.used()) == 208u;
+		expect(pool.deallocate(overflow.data, 16, 16)) == true;
+		expect(upstream.used()) == 192u;
+		for(auto* block : blocks) expect(pool.deallocate(block, 16, 16)) == true;
+	};
+
+	section<"failed growth">() = [&] {
+		// the first chunk (4 blocks of 16 bytes) fits, the second one (8 blocks) only once the blocker is released.
+		budget_resource<> upstream {16, 192};
+		concurrent_pool_resource<budget_resource<>> pool {16, 16, 4, &upstream};
+		std::vector<void*> blocks {};
+		for(int i = 0; i < 4; ++i) blocks.emplace_back(pool.allocate(16, 16).data);
+		auto blocker = upstream.allocate(128, 16);
+		expect((bool)blocker) == true;
+		expect((bool)pool.allocate(16, 16)) == false;
+		upstream.deallocate(blocker.data, 128, 16);
+
+		// every block of the second chunk is still handed out, none of them were lost to the failed allocation.
+		for(int i = 0; i < 8; ++i) {
+			auto res = pool.allocate(16, 16);
+			expect((bool)res) == true;
+			blocks.emplace_back(res.data);
+		}
+		expect(pool.capacity()) == 12u;
+		expect(upstream.used()) == 192u;
+		for(auto* block : blocks) expect(pool.deallocate(block, 16, 16)) == true;
+	};
+
+	section<"stress">() = [&] {
+		constexpr size_t thread_count = 8;
+		constexpr size_t iterations	  = 20000;
+		std::atomic<size_t> corrupted {0};
+		std::mutex lock {};
+		std::vector<std::uint64_t*> handover {};
+
+		std::vector<std::thread> threads {};
+		for(size_t t = 0; t < thread_count; ++t) {
+			threads.emplace_back([&, t] {
+				std::vector<std::uint64_t*> owned {};
+				for(size_t i = 0; i < iterations; ++i) {
+					auto* block = (std::uint64_t*)resource.allocate(48, 8).data;
+					std::fill(block, block + 6, t * iterations + i);
+					owned.emplace_back(block);
+
+					if(owned.size() == 16) {
+						// free half locally, hand the other half to whichever thread picks them up
+						for(size_t n = 0; n < 8; ++n) {
+							auto* value = owned.back();
+							owned.pop_back();
+							if(std::any_of(value, value + 6, [&](auto v) { return v != value[0]; }))
+								++corrupted;
+							resource.deallocate(value, 48, 8);
+						}
+						std::lock_guard guard {lock};
+						handover.insert(handover.end(), owned.begin(), owned.end());
+						owned.clear();
+						while(handover.size() > 32) {
+							auto* value = handover.back();
+							handover.pop_back();
+							if(std::any_of(value, value + 6, [&](auto v) { return v != value[0]; }))
+								++corrupted;
+							resource.deallocate(value, 48, 8);
+						}
+					}
+				}
+				for(auto* value : owned) resource.deallocate(value, 48, 8);
+			});
+		}
+		for(auto& thread : threads) thread.join();
+		for(auto* value : handover) resource.deallocate(value, 48, 8);
+		expect(corrupted.load()) == 0u;
+	};
+};
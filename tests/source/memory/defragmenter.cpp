@@ -0,0 +1,107 @@
+#include <psl/memory/defragmenter.hpp>
+#include <psl/memory/offset_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+#include <cstring>
+#include <vector>
+
+using namespace psl;
+using namespace litmus;
+
+auto defragmenter_test0 = suite<"defragmenter", "psl", "psl::memory">() = [] {
+	// the region is real memory so that the relocations can be verified, the resource itself never touches it.
+	alignas(256) static std::byte heap[256 * 16];
+	offset_resource resource {16, heap, sizeof(heap), 256};
+	defragmenter<offset_resource> defrag {resource};
+
+	auto copy = [](std::span<defragmenter<offset_resource>::relocation_t const> plan) {
+		for(auto const& relocation : plan) std::memcpy(relocation.destination, relocation.source, relocation.size);
+	};
+
+	section<"allocate">() = [&] {
+		int owner {0};
+		auto handle = defrag.allocate(100, 16, &owner);
+		expect(handle != nullptr) == true;
+		expect(handle->size) == 100u;
+		expect(handle->user_data) == (void*)&owner;
+		expect(defrag.size()) == 1u;
+		expect(defrag.live_bytes()) == 100u;
+		expect(defrag.allocate(sizeof(heap), 16) == nullptr) == true;
+
+		expect(defrag.deallocate(handle)) == true;
+		expect(defrag.size()) == 0u;
+		expect(resource.available()) == sizeof(heap);
+	};
+
+	section<"compaction">() = [&] {
+		// fill the heap, and free every other block so that no 2 granules are contiguous.
+		std::vector<defragmenter<offset_resource>::handle_t> handles {};
+		for(int i = 0; i < 16; ++i) {
+			handles.emplace_back(defrag.allocate(256, 16));
+			std::memset(handles.back()->data, i, 256);
+		}
+		for(size_t i = 0; i < 8; ++i) {
+			defrag.deallocate(handles[i]);
+			handles.erase(handles.begin() + i);
+		}
+		expect(resource.largest_available()) == 256u;
+
+		size_t steps {0};
+		size_t moves {0};
+		while(true) {
+			auto result = defrag.step(512, [&](auto plan) {
+				expect(plan.size() <= 2) == true;
+				for(auto const& relocation : plan) {
+					expect(relocation.destination < relocation.source) == true;
+					expect(relocation.allocation->data) == relocation.source;
+					for(auto const& other : plan)
+						expect(relocation.destination != other.source) == true;
+				}
+				copy(plan);
+			});
+			++steps;
+			moves += result.moves;
+			expect(result.bytes <= 512) == true;
+			if(result.completed && result.moves == 0)
+				break;
+		}
+		expect(steps > 1) == true;
+		expect(moves >= 4u) == true;
+		expect(resource.largest_available()) == 256u * 8;
+		expect(resource.fragments()) == 1u;
+
+		// every handle follows its allocation, and the contents were moved along.
+		for(auto handle : handles) {
+			auto value = std::to_integer<int>(*(std::byte*)handle->data);
+			expect(value % 2) == 1;
+			expect(std::to_integer<int>(((std::byte*)handle->data)[255])) == value;
+		}
+		for(auto handle : handles) expect(defrag.deallocate(handle)) == true;
+		expect(resource.available()) == sizeof(heap);
+	};
+
+	section<"budget">() = [&] {
+		auto front = defrag.allocate(1024, 16);
+		auto large = defrag.allocate(1024, 16);
+		defrag.deallocate(front);
+		// the only candidate is larger than the budget of a step, so it is never moved.
+		size_t calls {0};
+		auto result = defrag.step(512, [&](auto) { ++calls; });
+		expect(result.completed) == true;
+		expect(result.moves) == 0u;
+		expect(calls) == 0u;
+		result = defrag.step(1024, copy);
+		expect(result.moves) == 1u;
+		expect((std::byte*)large->data) == heap;
+		defrag.deallocate(large);
+	};
+
+	section<"foreign handles">() = [&] {
+		defragmenter<offset_resource>::allocation_t other {heap, 256, 16, nullptr};
+		expect(defrag.deallocate(&other)) == false;
+		expect(defrag.deallocate(nullptr)) == true;
+	};
+};
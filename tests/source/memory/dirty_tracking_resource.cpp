@@ -0,0 +1,89 @@
+#include <psl/array.hpp>
+#include <psl/memory/dirty_tracking_resource.hpp>
+#include <utility>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+auto dirty_tracking_resource_test0 = suite<"dirty_tracking_resource", "psl", "psl::memory">() = [] {
+	std::vector<std::pair<std::byte*, size_t>> flushed {};
+	auto hook = [&flushed](void* location, size_t size) { flushed.emplace_back((std::byte*)location, size); };
+
+	section<"merges ranges">() = [&] {
+		dirty_tracking_resource<> resource {16, hook};
+		auto block = (std::byte*)resource.allocate(1024, 16).data;
+
+		resource.mark_dirty(block + 100, 10);
+		resource.mark_dirty(block + 110, 10);	 // touches the first.
+		resource.mark_dirty(block + 105, 30);	 // overlaps both.
+		resource.mark_dirty(block + 200, 8);
+		resource.mark_dirty(block + 50, 8);
+		expect(resource.dirty_ranges()) == 3u;
+		expect(resource.dirty_bytes()) == 35u + 8u + 8u;
+		resource.mark_dirty(block + 40, 200);	 // swallows all of them.
+		expect(resource.dirty_ranges()) == 1u;
+
+		auto stats = resource.flush();
+		expect(stats.calls) == 1u;
+		expect(stats.bytes) == 200u;
+		expect(flushed.size()) == 1u;
+		expect(flushed[0].first) == block + 40;
+		expect(resource.dirty_ranges()) == 0u;
+		expect(resource.flush().calls) == 0u;
+
+		// out of range writes are rejected, and ranges are clipped to their allocation.
+		int value {0};
+		expect([&] { resource.mark_dirty(&value, sizeof(value)); }) == throws<>();
+		resource.mark_dirty(block + 1000, 100);
+		expect(resource.dirty_bytes() <= 24u) == true;
+		expect(resource.deallocate(block, 1024, 16)) == true;
+		expect(resource.dirty_ranges()) == 0u;
+		expect([&] { resource.mark_dirty(block, 1); }) == throws<>();
+	};
+
+	section<"granularity and gaps">() = [&] {
+		flushed.clear();
+		dirty_tracking_resource<> resource {64, hook, 64, 128};
+		auto first	= (std::byte*)resource.allocate(4096, 64).data;
+		auto second = (std::byte*)resource.allocate(4096, 64).data;
+
+		resource.mark_dirty(first + 70, 1);	   // rounds out to [64, 128).
+		resource.mark_dirty(first + 300, 1);   // [256, 320), within the gap of the first.
+		resource.mark_dirty(first + 1000, 1);  // [960, 1024), too far away.
+		resource.mark_dirty(second, 4096);
+		expect(resource.dirty_ranges()) == 3u;
+
+		auto stats = resource.flush();
+		expect(stats.calls) == 3u;
+		expect(stats.bytes) == 256u + 64u + 4096u;
+		expect(flushed[0].first) == first + 64;
+		expect(flushed[0].second) == 256u;
+		expect(flushed[1].first) == first + 960;
+		expect(flushed[2].first) == second;
+		resource.deallocate(first, 4096, 64);
+		resource.deallocate(second, 4096, 64);
+	};
+
+	section<"sparse array updates">() = [&] {
+		flushed.clear();
+		using allocator_t = allocator<traits::shareable_t<true>,
+									  traits::basic_allocation,
+									  traits::host_writability_t<traits::syncronization::flush>>;
+		dirty_tracking_resource<> resource {alignof(float), hook, 64};
+		psl::array<float, dynamic_extent, settings::array<allocator_t, default_t, 0>> values {allocator_t {&resource}};
+		values.resize(1 << 16);
+
+		for(size_t i = 0; i < values.size(); i += 4096) {
+			values[i] = (float)i;
+			resource.mark_dirty(std::span {&values[i], 1});
+		}
+		auto stats = resource.flush();
+		expect(stats.calls) == 16u;
+		expect(stats.bytes) == 16u * 64u;
+	};
+};
@@ -0,0 +1,66 @@
+#include <psl/memory/fallback_resource.hpp>
+#include <psl/memory/offset_resource.hpp>
+#include <psl/memory/tlsf_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+#include <array>
+
+using namespace psl;
+using namespace litmus;
+
+auto fallback_resource_test0 = suite<"fallback_resource", "psl", "psl::memory">() = [] {
+	alignas(64) static std::byte buffer[1 << 12];
+	fallback_resource<tlsf_resource<>, new_resource> resource {
+	  alignof(int), std::forward_as_tuple(alignof(int), buffer, sizeof(buffer)), std::tuple {1}};
+	static_assert(traits::IsShareable<decltype(resource)>);
+	static_assert(!traits::IsSizeQueryable<decltype(resource)>);
+
+	auto in_buffer = [&](void* ptr) { return ptr >= (void*)buffer && ptr < (void*)(buffer + sizeof(buffer)); };
+
+	section<"falls back when the primary runs out">() = [&] {
+		auto first = resource.allocate(1024, alignof(int));
+		expect(in_buffer(first.data)) == true;
+		auto second = resource.allocate(1 << 12, alignof(int));
+		expect((bool)second) == true;
+		expect(in_buffer(second.data)) == false;
+
+		// every block is returned to the resource that allocated it.
+		expect(resource.deallocate(second.data, 1 << 12, alignof(int))) == true;
+		expect(resource.deallocate(first.data, 1024, alignof(int))) == true;
+		expect(resource.primary().available()) == sizeof(buffer);
+	};
+
+	section<"batch">() = [&] {
+		std::array<void*, 32> blocks {};
+		expect(resource.allocate_batch(256, alignof(int), blocks.size(), blocks.data())) == blocks.size();
+		expect(in_buffer(blocks.front())) == true;
+		expect(in_buffer(blocks.back())) == false;
+		expect(resource.deallocate_batch(blocks.data(), blocks.size(), 256, alignof(int))) == true;
+		expect(resource.primary().available()) == sizeof(buffer);
+	};
+};
+
+auto fallback_resource_test1 = suite<"fallback_resource", "psl", "psl::memory">() = [] {
+	// simulated device heaps, the regions are never dereferenced.
+	fallback_resource<offset_resource, offset_resource> resource {
+	  256,
+	  std::forward_as_tuple(256, (void*)std::uintptr_t {0x10000}, size_t {1} << 12),
+	  std::forward_as_tuple(256, (void*)std::uintptr_t {0x100000}, size_t {1} << 16)};
+	static_assert(traits::IsVirtuallyAllocated<decltype(resource)>);
+	static_assert(traits::IsSizeQueryable<decltype(resource)>);
+
+	section<"virtual heaps">() = [&] {
+		expect(resource.size()) == (size_t {1} << 12) + (size_t {1} << 16);
+		auto first	= resource.allocate(1 << 12, 1);
+		auto second = resource.allocate(256, 1);
+		expect((std::uintptr_t)first.data) == std::uintptr_t {0x10000};
+		expect((std::uintptr_t)second.data) == std::uintptr_t {0x100000};
+		expect(resource.deallocate(second.data, 256, 1)) == true;
+		expect(resource.deallocate(first.data, 1 << 12, 1)) == true;
+		expect(resource.primary().available()) == size_t {1} << 12;
+		expect(resource.secondary().available()) == size_t {1} << 16;
+	};
+};
@@ -0,0 +1,42 @@
+#include <psl/array.hpp>
+#include <psl/memory/huge_page_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+auto huge_page_resource_test0 = suite<"huge_page_resource", "psl", "psl::memory">() = [] {
+	huge_page_resource<> resource {alignof(float)};
+	auto huge_page = _priv::virtual_memory::huge_page_size();
+
+	section<"allocate">() = [&] {
+		auto small = resource.allocate(1024, 4);
+		expect((bool)small) == true;
+		expect(resource.mapped_bytes()) == 0u;
+
+		auto large = resource.allocate(huge_page + 1, 4);
+		expect((bool)large) == true;
+		expect((std::uintptr_t)large.data % huge_page) == 0u;
+		expect(large.size()) == 2 * huge_page;
+		expect(resource.mapped_bytes()) == 2 * huge_page;
+		expect(resource.advised_bytes() <= resource.mapped_bytes()) == true;
+		std::fill_n((std::byte*)large.data, large.size(), std::byte {0xff});
+
+		resource.deallocate(large.data, huge_page + 1, 4);
+		resource.deallocate(small.data, 1024, 4);
+		expect(resource.mapped_bytes()) == 0u;
+		expect(resource.advised_bytes()) == 0u;
+	};
+
+	section<"array">() = [&] {
+		psl::allocator<traits::shareable_t<true>, traits::basic_allocation> allocator {&resource};
+		psl::array<float> arr {allocator};
+		arr.resize(1 << 20, 1.0f);
+		expect(resource.mapped_bytes() >= (1 << 20) * sizeof(float)) == true;
+		expect((std::uintptr_t)&arr[0] % huge_page) == 0u;
+		expect(arr[(1 << 20) - 1]) == 1.0f;
+	};
+};
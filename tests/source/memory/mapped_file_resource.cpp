@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <filesystem>
+#include <psl/array.hpp>
+#include <psl/memory/mapped_file_resource.hpp>
+#include <random>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+#if defined(__linux__) || defined(__APPLE__)
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+using namespace psl;
+using namespace litmus;
+
+namespace {
+struct entry_t {
+	std::uint32_t key;
+	float value;
+};
+
+using mapped_allocator_t =
+  psl::allocator<traits::shareable_t<true>, traits::basic_allocation, traits::queryable_size_t>;
+using table_t = psl::array<entry_t, dynamic_extent, settings::array<mapped_allocator_t>>;
+
+constexpr size_t table_size {10000};
+constexpr std::uint64_t table_layout {0x7ab1e};
+
+bool verify(std::span<entry_t const> table) {
+	if(table.size() != table_size)
+		return false;
+	for(size_t i = 0; i < table.size(); ++i)
+		if(table[i].key != i * 3 || table[i].value != (float)i * 0.5f)
+			return false;
+	return true;
+}
+}	 // namespace
+
+auto mapped_file_resource_test0 = suite<"mapped_file_resource", "psl", "psl::memory">() = [] {
+	auto path = (std::filesystem::temp_directory_path() / "psl_mapped_file_resource_test.bin").string();
+	using open_mode = mapped_file_resource::open_mode;
+
+	section<"persists a table">() = [&] {
+		{
+			mapped_file_resource resource {alignof(entry_t), path.c_str(), open_mode::create, 1 << 20, table_layout};
+			table_t table {mapped_allocator_t {&resource}};
+			table.reserve(table_size);
+			for(size_t i = 0; i < table_size; ++i) table.emplace_back((std::uint32_t)(i * 3), (float)i * 0.5f);
+			resource.set_root(0, &table[0], table.size());
+			expect(resource.flush()) == true;
+			// the table's storage is pinned by the root, so it survives the array.
+		}
+
+		{
+			// mapped again while another mapping of the file exists, so it lives at another address.
+			mapped_file_resource first {alignof(entry_t), path.c_str(), open_mode::open, 0, table_layout};
+			mapped_file_resource second {alignof(entry_t), path.c_str(), open_mode::open, 0, table_layout};
+			expect(first.root<entry_t>(0).data() != second.root<entry_t>(0).data()) == true;
+			expect(verify(second.root<entry_t>(0))) == true;
+			expect(second.root<entry_t>(1).empty()) == true;
+			expect([&] { second.root<double>(0); }) == throws<>();
+		}
+
+#if defined(__linux__) || defined(__APPLE__)
+		// remap and verify the table in a fresh process.
+		auto child = fork();
+		if(child == 0) {
+			bool valid {false};
+			try {
+				mapped_file_resource resource {alignof(entry_t), path.c_str(), open_mode::open, 0, table_layout};
+				valid = verify(resource.root<entry_t>(0));
+			} catch(...) {
+			}
+			_exit(valid ? 0 : 1);
+		}
+		int status {-1};
+		expect(child > 0) == true;
+		expect(waitpid(child, &status, 0)) == child;
+		expect(WIFEXITED(status) && WEXITSTATUS(status) == 0) == true;
+#endif
+
+		{
+			// the table can be extended once the file is opened again.
+			mapped_file_resource resource {alignof(entry_t), path.c_str(), open_mode::open_or_create, 0, table_layout};
+			auto table = resource.root<entry_t>(0);
+			auto extra = resource.allocate(100, alignof(entry_t));
+			expect((bool)extra) == true;
+			expect((std::byte*)extra.data >= (std::byte*)(table.data() + table.size())) == true;
+			expect(resource.deallocate(extra.data, 100, alignof(entry_t))) == true;
+			resource.release_root(0);
+			expect(resource.header().top) == sizeof(mapped_file_header_t);
+		}
+		std::filesystem::remove(path);
+	};
+
+	section<"header checks">() = [&] {
+		expect([&] { mapped_file_resource {8, path.c_str(), open_mode::open}; }) == throws<>();
+		{ mapped_file_resource resource {8, path.c_str(), open_mode::create, 1 << 16, 1}; }
+		expect([&] { mapped_file_resource {8, path.c_str(), open_mode::open, 0, 2}; }) == throws<>();
+		{
+			std::unique_ptr<std::FILE, int (*)(std::FILE*)> file {std::fopen(path.c_str(), "r+b"), &std::fclose};
+			std::fwrite("NOTAFILE", 1, 8, file.get());
+		}
+		expect([&] { mapped_file_resource {8, path.c_str(), open_mode::open, 0, 1}; }) == throws<>();
+		std::filesystem::remove(path);
+	};
+
+	section<"bookkeeping">() = [&] {
+		mapped_file_resource resource {16, path.c_str(), open_mode::create, 1 << 16};
+		expect(resource.size()) == size_t {1 << 16};
+
+		auto first	= resource.allocate(100, 16);
+		auto second = resource.allocate(200, 16);
+		auto third	= resource.allocate(300, 256);
+		expect((std::uintptr_t)third.data % 256) == 0u;
+		expect(first.size() >= 100) == true;
+
+		// freed blocks are reused, and merged with their free neighbours.
+		expect(resource.deallocate(first.data, 100, 16)) == true;
+		auto reuse = resource.allocate(50, 16);
+		expect(reuse.data) == first.data;
+		expect(resource.deallocate(reuse.data, 50, 16)) == true;
+		expect(resource.deallocate(second.data, 200, 16)) == true;
+		auto merged = resource.allocate(300, 16);
+		expect(merged.data) == first.data;
+		expect(resource.deallocate(merged.data, 300, 16)) == true;
+
+		// a rooted allocation is only released along with its root.
+		resource.set_root(3, (std::byte const*)third.data, 300);
+		expect(resource.deallocate(third.data, 300, 256)) == true;
+		expect(resource.root<std::byte>(3).data()) == third.data;
+		resource.release_root(3);
+		expect(resource.header().top) == sizeof(mapped_file_header_t);
+		expect(resource.header().free_list) == 0u;
+
+		std::mt19937 rng {1337};
+		std::vector<std::pair<void*, size_t>> live {};
+		for(size_t i = 0; i < 10000; ++i) {
+			if(live.empty() || rng() % 3 != 0) {
+				auto size = 1 + rng() % 1024;
+				if(auto res = resource.allocate(size, size_t {16} << (rng() % 3)))
+					live.emplace_back(res.data, size);
+			} else {
+				auto index = rng() % live.size();
+				expect(resource.deallocate(live[index].first, live[index].second, 16)) == true;
+				live[index] = live.back();
+				live.pop_back();
+			}
+		}
+		std::shuffle(live.begin(), live.end(), rng);
+		for(auto [block, size] : live) resource.deallocate(block, size, 16);
+		expect(resource.header().top) == sizeof(mapped_file_header_t);
+		expect(resource.header().free_list) == 0u;
+
+		int value {0};
+		expect(resource.deallocate(&value, sizeof(int), alignof(int))) == false;
+		expect(resource.allocate(1 << 17, 16)) == false;
+	};
+
+	section<"aligned tails">() = [&] {
+		mapped_file_resource resource {64, path.c_str(), open_mode::create, 1 << 16};
+		std::vector<alloc_results<void>> blocks {};
+		for(size_t size : {1u, 16u, 63u, 64u, 65u, 100u, 200u}) {
+			auto block = resource.allocate(size, 64);
+			expect((bool)block) == true;
+			expect((std::uintptr_t)block.data % 64) == 0u;
+			expect((std::uintptr_t)block.tail % 64) == 0u;
+			expect(block.size() >= size) == true;
+			blocks.emplace_back(block);
+		}
+		for(auto& block : blocks) expect(resource.deallocate(block.data, block.size(), 64)) == true;
+		expect(resource.header().top) == sizeof(mapped_file_header_t);
+	};
+
+	section<"container outlives its root">() = [&] {
+		mapped_file_resource resource {alignof(entry_t), path.c_str(), open_mode::create, 1 << 20, table_layout};
+		{
+			table_t table {mapped_allocator_t {&resource}};
+			table.reserve(table.sbo_size() * 2);
+			table.emplace_back(1u, 1.0f);
+			resource.set_root(0, &table[0], table.size());
+			resource.release_root(0);
+			// the table still owns its storage.
+			table.emplace_back(2u, 2.0f);
+			expect(table[0].key) == 1u;
+
+			// moving the root to another allocation leaves the table's storage alone as well.
+			auto other = resource.allocate(sizeof(entry_t), alignof(entry_t));
+			resource.set_root(1, &table[0], table.size());
+			resource.set_root(1, (entry_t const*)other.data, 1);
+			expect(table[1].key) == 2u;
+			resource.release_root(1);
+			expect(resource.deallocate(other.data, sizeof(entry_t), alignof(entry_t))) == true;
+		}
+		expect(resource.header().top) == sizeof(mapped_file_header_t);
+
+		{
+			// the other way around, the root outlives the table and frees its storage when released.
+			table_t table {mapped_allocator_t {&resource}};
+			table.reserve(table.sbo_size() * 2);
+			table.emplace_back(3u, 3.0f);
+			resource.set_root(2, &table[0], table.size());
+			resource.set_root(2, &table[0], table.size());
+		}
+		expect(resource.root<entry_t>(2)[0].key) == 3u;
+		resource.release_root(2);
+		expect(resource.header().top) == sizeof(mapped_file_header_t);
+		expect(resource.header().free_list) == 0u;
+	};
+	std::filesystem::remove(path);
+};
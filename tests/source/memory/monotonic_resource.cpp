@@ -0,0 +1,122 @@
+#include <array>
+#include <psl/array.hpp>
+#include <psl/memory/monotonic_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+namespace {
+using arena_allocator_t = psl::allocator<traits::shareable_t<false>, traits::basic_allocation>;
+}
+
+auto monotonic_resource_test0 = suite<"monotonic_resource", "psl", "psl::memory">() = [] {
+	static_assert(traits::HasTrait<monotonic_resource<>, traits::shareable_t<false>>);
+	static_assert(!traits::IsShareable<monotonic_resource<>>);
+
+	section<"buffer">() = [] {
+		alignas(16) std::byte buffer[256];
+		monotonic_resource<> resource {alignof(int), buffer, sizeof(buffer)};
+
+		auto first = resource.allocate(sizeof(int), alignof(int));
+		expect((bool)first) == true;
+		expect(first.data) == (void*)&buffer[0];
+
+		auto second = resource.allocate(24, 8);
+		expect((std::uintptr_t)second.data % 8) == 0u;
+		expect((std::byte*)second.data >= first.tail) == true;
+
+		section<"exhaust">() = [&] {
+			auto res = resource.allocate(512, 1);
+			expect((bool)res) == false;
+		};
+
+		section<"reset">() = [&] {
+			resource.reset();
+			auto res = resource.allocate(sizeof(int), alignof(int));
+			expect(res.data) == first.data;
+		};
+
+		section<"rewind">() = [&] {
+			auto marker = resource.marker();
+			auto third	= resource.allocate(32, 4);
+			[[maybe_unused]] auto fourth = resource.allocate(32, 4);
+			resource.rewind(marker);
+			auto res = resource.allocate(32, 4);
+			expect(res.data) == third.data;
+		};
+
+		section<"deallocate last">() = [&] {
+			expect(resource.deallocate(second.data, 24, 8)) == true;
+			auto res = resource.allocate(24, 8);
+			expect(res.data) == second.data;
+		};
+	};
+
+	section<"upstream">() = [] {
+		new_resource upstream {alignof(std::max_align_t)};
+		monotonic_resource<new_resource> resource {alignof(int), 64, &upstream};
+
+		std::byte* previous = nullptr;
+		for(int i = 0; i < 64; ++i) {
+			auto res = resource.allocate(sizeof(int) * 8, alignof(int));
+			expect((bool)res) == true;
+			expect((std::byte*)res.data != previous) == true;
+			previous = (std::byte*)res.data;
+		}
+
+		auto large = resource.allocate(8192, 64);
+		expect((bool)large) == true;
+		expect((std::uintptr_t)large.data % 64) == 0u;
+
+		resource.reset();
+		auto first = resource.allocate(sizeof(int), alignof(int));
+		expect((bool)first) == true;
+
+		resource.release();
+		auto after_release = resource.allocate(sizeof(int), alignof(int));
+		expect((bool)after_release) == true;
+	};
+
+	section<"buffer with upstream fallback">() = [] {
+		alignas(16) std::byte buffer[64];
+		monotonic_resource<> resource {alignof(int), buffer, sizeof(buffer), &psl::default_memory_resource};
+		auto inside = resource.allocate(48, 4);
+		expect((std::byte*)inside.data) == &buffer[0];
+		auto outside = resource.allocate(48, 4);
+		expect((bool)outside) == true;
+		expect((std::byte*)outside.data < &buffer[0] || (std::byte*)outside.data >= &buffer[64]) == true;
+	};
+
+	section<"batch">() = [] {
+		alignas(16) std::byte buffer[256];
+		monotonic_resource<> resource {alignof(int), buffer, sizeof(buffer), &psl::default_memory_resource};
+
+		std::array<void*, 8> items {};
+		expect(resource.allocate_batch(12, 8, items.size(), items.data())) == items.size();
+		for(size_t i = 0; i < items.size(); ++i) expect(items[i]) == (void*)&buffer[i * 16];
+
+		expect(resource.deallocate_batch(items.data(), items.size(), 12, 8)) == true;
+		auto res = resource.allocate(4, 4);
+		expect(res.data) == (void*)&buffer[0];
+
+		std::array<void*, 64> grown {};
+		expect(resource.allocate_batch(12, 8, grown.size(), grown.data())) == grown.size();
+		for(size_t i = 1; i < grown.size(); ++i) expect((std::byte*)grown[i] - (std::byte*)grown[i - 1]) == 16;
+	};
+
+	section<"array">() = [] {
+		monotonic_resource<> resource {alignof(int)};
+		arena_allocator_t allocator {&resource};
+
+		using array_t = psl::array<int, psl::dynamic_extent, settings::array<arena_allocator_t>>;
+		array_t arr {allocator};
+		for(int i = 0; i < 1024; ++i) arr.emplace_back(i);
+		expect(arr.size()) == 1024u;
+		expect(arr.is_stored_inlined()) == false;
+		for(int i = 0; i < 1024; ++i) expect(arr[i]) == i;
+	};
+};
@@ -0,0 +1,133 @@
+#include <psl/memory/offset_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace psl;
+using namespace litmus;
+
+auto offset_resource_test0 = suite<"offset_resource", "psl", "psl::memory">() = [] {
+	// simulated device heap, the region is never dereferenced.
+	constexpr std::uintptr_t base {0x10000};
+	offset_resource resource {16, (void*)base, 1 << 20, 256};
+	static_assert(traits::IsSizeQueryable<offset_resource>);
+	static_assert(traits::IsVirtuallyAllocated<offset_resource>);
+
+	section<"construction">() = [&] {
+		expect(resource.size()) == size_t {1 << 20};
+		expect(resource.available()) == size_t {1 << 20};
+		expect(resource.granularity()) == 256u;
+		expect(resource.fragments()) == 1u;
+
+		offset_resource rounded {16, (void*)base, 1000, 100};
+		expect(rounded.granularity()) == 128u;
+		expect(rounded.size()) == 896u;
+
+		expect([&] { offset_resource {16, nullptr, 1 << 20}; }) == throws<>();
+		expect([&] { offset_resource {16, (void*)(base + 64), 1 << 20}; }) == throws<>();
+		expect([&] { offset_resource {16, (void*)base, 100}; }) == throws<>();
+	};
+
+	section<"allocate">() = [&] {
+		auto first = resource.allocate(1000, 1);
+		expect((std::uintptr_t)first.data) == base;
+		expect(resource.offset(first.data)) == 0u;
+		expect(first.size()) == 1024u;
+		auto second = resource.allocate(1 << 16, 1 << 16);
+		expect((std::uintptr_t)second.data % (1 << 16)) == 0u;
+		expect(resource.available()) == size_t {(1 << 20) - 1024 - (1 << 16)};
+		// the unaligned front of the range that served `second` remains free.
+		auto third = resource.allocate(1, 1);
+		expect(resource.offset(third.data)) == 1024u;
+		expect(resource.allocate(2 << 20, 1)) == false;
+
+		expect(resource.deallocate(second.data, 1 << 16, 1 << 16)) == true;
+		expect(resource.deallocate(first.data, 1000, 1)) == true;
+		expect(resource.deallocate(third.data, 1, 1)) == true;
+		expect(resource.available()) == size_t {1 << 20};
+		expect(resource.fragments()) == 1u;
+	};
+
+	section<"best fit">() = [&] {
+		std::vector<void*> blocks {};
+		for(size_t i = 0; i < 8; ++i) blocks.emplace_back(resource.allocate(256 * (i + 1), 1).data);
+		// free a large and a small hole, separated by live blocks.
+		resource.deallocate(blocks[6], 256 * 7, 1);
+		resource.deallocate(blocks[1], 256 * 2, 1);
+		expect(resource.fragments()) == 3u;
+
+		auto small = resource.allocate(300, 1);
+		expect(small.data) == blocks[1];
+		expect(resource.fragments()) == 2u;
+		auto large = resource.allocate(256 * 5, 1);
+		expect(large.data) == blocks[6];
+		expect(resource.largest_available()) == size_t {(1 << 20) - 256 * 36};
+
+		resource.deallocate(small.data, 300, 1);
+		resource.deallocate(large.data, 256 * 5, 1);
+		for(size_t i : {0, 2, 3, 4, 5, 7}) resource.deallocate(blocks[i], 256 * (i + 1), 1);
+		expect(resource.available()) == size_t {1 << 20};
+		expect(resource.fragments()) == 1u;
+	};
+
+	section<"aligned fit">() = [&] {
+		auto front = resource.allocate(256, 1);
+		auto hole  = resource.allocate(1024, 1);
+		auto back  = resource.allocate(256, 1);
+		resource.deallocate(hole.data, 1024, 1);
+
+		// the hole is large enough, but can't fit the aligned allocation, which moves on to a range that surely can.
+		auto aligned = resource.allocate(1024, 1024);
+		expect(resource.offset(aligned.data)) == 2048u;
+		expect(resource.fragments()) == 3u;
+		auto unaligned = resource.allocate(1024, 1);
+		expect(unaligned.data) == hole.data;
+
+		for(auto block : {front, back, unaligned, aligned}) resource.deallocate(block.data, block.size(), 1);
+		expect(resource.available()) == size_t {1 << 20};
+		expect(resource.fragments()) == 1u;
+	};
+
+	section<"invalid deallocations">() = [&] {
+		int value {0};
+		expect(resource.deallocate(&value, sizeof(int), alignof(int))) == false;
+		expect(resource.deallocate(nullptr, 16, 1)) == true;
+
+		auto block = resource.allocate(512, 1);
+		expect(resource.deallocate((std::byte*)block.data + 16, 256, 1)) == false;
+		expect(resource.deallocate(block.data, 512, 1)) == true;
+		expect(resource.deallocate(block.data, 512, 1)) == false;
+		expect(resource.deallocate((void*)(base + (1 << 20) - 256), 512, 1)) == false;
+		expect(resource.available()) == size_t {1 << 20};
+	};
+
+	section<"random">() = [&] {
+		std::mt19937 rng {1337};
+		std::vector<std::pair<void*, size_t>> live {};
+		for(size_t i = 0; i < 20000; ++i) {
+			if(live.empty() || rng() % 3 != 0) {
+				auto size	   = 1 + rng() % 8192;
+				auto alignment = size_t {1} << (rng() % 12);
+				auto res	   = resource.allocate(size, alignment);
+				if(!res)
+					continue;
+				expect((std::uintptr_t)res.data % alignment) == 0u;
+				live.emplace_back(res.data, size);
+			} else {
+				auto index = rng() % live.size();
+				expect(resource.deallocate(live[index].first, live[index].second, 1)) == true;
+				live[index] = live.back();
+				live.pop_back();
+			}
+		}
+		std::shuffle(live.begin(), live.end(), rng);
+		for(auto [block, size] : live) resource.deallocate(block, size, 1);
+		expect(resource.available()) == size_t {1 << 20};
+		expect(resource.fragments()) == 1u;
+	};
+};
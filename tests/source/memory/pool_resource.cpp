@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <array>
+#include <psl/array.hpp>
+#include <psl/memory/pool_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+auto pool_resource_test0 = suite<"pool_resource", "psl", "psl::memory">() = [] {
+	pool_resource<> resource {alignof(int)};
+
+	section<"size classes">() = [&] {
+		expect(resource.slot_size(1, 1)) == 16u;
+		expect(resource.slot_size(17, 1)) == 32u;
+		expect(resource.slot_size(100, 4)) == 112u;
+		expect(resource.slot_size(129, 8)) == 160u;
+		expect(resource.slot_size(1000, 8)) == 1024u;
+		expect(resource.slot_size(48, 32)) == 64u;
+		expect(resource.slot_size(2048, 8)) == 0u;
+	};
+
+	section<"reports slot size">() = [&] {
+		auto res = resource.allocate(100, alignof(int));
+		expect((bool)res) == true;
+		expect(res.size()) == 112u;
+		expect(resource.deallocate(res.data, 100, alignof(int))) == true;
+	};
+
+	section<"reuses freed slots">() = [&] {
+		auto first	= resource.allocate(24, 8);
+		auto second = resource.allocate(24, 8);
+		expect(first.data != second.data) == true;
+		expect((std::uintptr_t)first.data % 8) == 0u;
+		resource.deallocate(first.data, 24, 8);
+		auto third = resource.allocate(20, 8);
+		expect(third.data) == first.data;
+		resource.deallocate(second.data, 24, 8);
+		resource.deallocate(third.data, 20, 8);
+	};
+
+	section<"alignment">() = [&] {
+		for(size_t alignment = 1; alignment <= 256; alignment *= 2) {
+			auto res = resource.allocate(40, alignment);
+			expect((bool)res) == true;
+			expect((std::uintptr_t)res.data % alignment) == 0u;
+			resource.deallocate(res.data, 40, alignment);
+		}
+	};
+
+	section<"large allocations">() = [&] {
+		auto res = resource.allocate(4096, 16);
+		expect((bool)res) == true;
+		expect(res.size() >= 4096u) == true;
+		expect(resource.deallocate(res.data, 4096, 16)) == true;
+	};
+
+	section<"many nodes">() = [&] {
+		config::default_allocator_t allocator {&resource};
+		std::array<int*, 4096> nodes {};
+		for(int i = 0; i < (int)nodes.size(); ++i) nodes[i] = construct<int>(allocator, i).data;
+		for(int i = 0; i < (int)nodes.size(); ++i) expect(*nodes[i]) == i;
+		for(auto* node : nodes) destroy(allocator, *node);
+	};
+
+	section<"batch">() = [&] {
+		auto single = resource.allocate(24, 8);
+		resource.deallocate(single.data, 24, 8);
+
+		std::array<void*, 4096> items {};
+		expect(resource.allocate_batch(24, 8, items.size(), items.data())) == items.size();
+		expect(items[0]) == single.data;
+		for(auto* item : items) {
+			expect((std::uintptr_t)item % 8) == 0u;
+			std::fill_n((std::byte*)item, 24, std::byte {0xff});
+		}
+		std::sort(items.begin(), items.end());
+		expect(std::adjacent_find(items.begin(), items.end()) == items.end()) == true;
+
+		expect(resource.deallocate_batch(items.data(), 16, 24, 8)) == true;
+		for(size_t i = 16; i < items.size(); ++i) resource.deallocate(items[i], 24, 8);
+		std::array<void*, 16> reused {};
+		expect(resource.allocate_batch(20, 8, reused.size(), reused.data())) == reused.size();
+		for(auto* item : reused) expect(std::binary_search(items.begin(), items.end(), item)) == true;
+		resource.deallocate_batch(reused.data(), reused.size(), 20, 8);
+
+		std::array<void*, 4> large {};
+		expect(resource.allocate_batch(4096, 16, large.size(), large.data())) == large.size();
+		expect(resource.deallocate_batch(large.data(), large.size(), 4096, 16)) == true;
+	};
+
+	section<"array uses slack">() = [&] {
+		config::default_allocator_t allocator {&resource};
+		psl::array<int> arr {allocator};
+		arr.reserve(100);
+		expect(arr.capacity()) == resource.slot_size(100 * sizeof(int), alignof(int)) / sizeof(int);
+		for(int i = 0; i < 200; ++i) arr.emplace_back(i);
+		for(int i = 0; i < 200; ++i) expect(arr[i]) == i;
+	};
+};
@@ -0,0 +1,92 @@
+#include <psl/memory/monotonic_resource.hpp>
+#include <psl/memory/offset_resource.hpp>
+#include <psl/memory/pool_resource.hpp>
+#include <psl/memory/segregator_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+#include <array>
+
+using namespace psl;
+using namespace litmus;
+
+using small_pool_t = pool_resource<new_resource>;
+
+auto segregator_resource_test0 = suite<"segregator_resource", "psl", "psl::memory">() = [] {
+	new_resource upstream {1};
+	segregator_resource<200, small_pool_t, new_resource> resource {
+	  alignof(int), std::forward_as_tuple(alignof(int), small_pool_t::default_slab_size, &upstream), std::tuple {8}};
+	static_assert(traits::IsShareable<decltype(resource)>);
+	static_assert(!traits::IsSizeQueryable<decltype(resource)>);
+	static_assert(!traits::IsShareable<segregator_resource<256, pool_resource<>, monotonic_resource<>>>);
+	static_assert(traits::IsVirtuallyAllocated<segregator_resource<256, offset_resource, offset_resource>>);
+	static_assert(traits::IsSizeQueryable<segregator_resource<256, offset_resource, offset_resource>>);
+
+	section<"routes on size">() = [&] {
+		auto small = resource.allocate(195, alignof(int));
+		// the pool's slot is larger than the threshold, reporting that would route its deallocation to `new_resource`.
+		expect(resource.small().slot_size(195, alignof(int))) == 224u;
+		expect(small.size()) == 200u;
+		auto large = resource.allocate(201, alignof(int));
+		expect(large.size() >= 201) == true;
+
+		expect(resource.deallocate(small.data, small.size(), alignof(int))) == true;
+		expect(resource.deallocate(large.data, 201, alignof(int))) == true;
+		// the freed slot is reused by the pool.
+		auto again = resource.allocate(200, alignof(int));
+		expect(again.data) == small.data;
+		resource.deallocate(again.data, 200, alignof(int));
+	};
+
+	section<"batch">() = [&] {
+		std::array<void*, 16> blocks {};
+		expect(resource.allocate_batch(64, alignof(int), blocks.size(), blocks.data())) == blocks.size();
+		expect(resource.deallocate_batch(blocks.data(), blocks.size(), 64, alignof(int))) == true;
+		expect(resource.allocate_batch(1024, alignof(int), blocks.size(), blocks.data())) == blocks.size();
+		expect(resource.deallocate_batch(blocks.data(), blocks.size(), 1024, alignof(int))) == true;
+	};
+
+	section<"allocator">() = [&] {
+		psl::allocator<traits::shareable_t<true>, traits::basic_allocation> allocator {&resource};
+		auto value = psl::construct<int>(allocator, 5);
+		expect(*value.data) == 5;
+		psl::destroy(allocator, *value.data);
+	};
+};
+
+auto segregator_resource_test1 = suite<"segregator_resource", "psl", "psl::memory">() = [] {
+	// simulated device heaps, the regions are never dereferenced.
+	segregator_resource<4096, offset_resource, offset_resource> resource {
+	  256,
+	  std::forward_as_tuple(256, (void*)std::uintptr_t {0x10000}, size_t {1} << 16),
+	  std::forward_as_tuple(256, (void*)std::uintptr_t {0x100000}, size_t {1} << 20)};
+
+	section<"virtual heaps">() = [&] {
+		expect(resource.size()) == (size_t {1} << 16) + (size_t {1} << 20);
+		auto small = resource.allocate(1000, 1);
+		auto large = resource.allocate(8192, 1);
+		expect((std::uintptr_t)small.data) == std::uintptr_t {0x10000};
+		expect((std::uintptr_t)large.data) == std::uintptr_t {0x100000};
+		expect(resource.deallocate(small.data, 1000, 1)) == true;
+		expect(resource.deallocate(large.data, 8192, 1)) == true;
+		expect(resource.small().available()) == size_t {1} << 16;
+		expect(resource.large().available()) == size_t {1} << 20;
+	};
+};
+
+auto segregator_resource_test2 = suite<"segregator_resource", "psl", "psl::memory">() = [] {
+	section<"threshold is not a multiple of the alignment">() = [] {
+		segregator_resource<100, pool_resource<>, new_resource> resource {8};
+
+		for(size_t size = 90; size <= 110; ++size) {
+			auto block = resource.allocate(size, 8);
+			expect((bool)block) == true;
+			expect(block.size() >= size && block.size() % 8 == 0) == true;
+			// sizes that round up past the threshold are served by the large resource.
+			expect(block.size() <= 96u || size > 96) == true;
+			expect(resource.deallocate(block.data, block.size(), 8)) == true;
+		}
+	};
+};
@@ -0,0 +1,195 @@
+#include <psl/array.hpp>
+#include <psl/memory/shared_memory_resource.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+#if defined(__linux__) || defined(__APPLE__)
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+using namespace psl;
+using namespace litmus;
+
+namespace {
+struct entry_t {
+	std::uint32_t key;
+	float value;
+};
+
+using shared_allocator_t =
+  psl::allocator<traits::shareable_t<true>, traits::basic_allocation, traits::queryable_size_t>;
+using table_t = psl::array<entry_t, dynamic_extent, settings::array<shared_allocator_t>>;
+
+constexpr std::uint64_t table_layout {0x5a4ed};
+
+void fill(table_t& table, size_t count, std::uint32_t step) {
+	table.reserve(count);
+	for(size_t i = 0; i < count; ++i) table.emplace_back((std::uint32_t)i * step, (float)i * 0.5f);
+}
+
+bool verify(std::span<entry_t const> table, size_t count, std::uint32_t step) {
+	if(table.size() != count)
+		return false;
+	for(size_t i = 0; i < table.size(); ++i)
+		if(table[i].key != i * step || table[i].value != (float)i * 0.5f)
+			return false;
+	return true;
+}
+
+// allocates and frees random blocks, and checks that no other thread or process wrote to them in the meantime.
+bool stress(shared_memory_resource& resource, std::uint8_t pattern, std::uint32_t seed) {
+	std::mt19937 rng {seed};
+	std::vector<std::pair<std::uint8_t*, size_t>> live {};
+	bool valid {true};
+	auto release = [&](size_t index) {
+		auto [block, size] = live[index];
+		for(size_t i = 0; i < size; ++i) valid &= block[i] == pattern;
+		valid &= resource.deallocate(block, size, 16);
+		live[index] = live.back();
+		live.pop_back();
+	};
+	for(size_t i = 0; i < 20000; ++i) {
+		if(live.empty() || rng() % 3 != 0) {
+			auto size = 1 + rng() % 512;
+			if(auto res = resource.allocate(size, 16)) {
+				std::memset(res.data, pattern, size);
+				live.emplace_back((std::uint8_t*)res.data, size);
+			}
+		} else
+			release(rng() % live.size());
+	}
+	while(!live.empty()) release(live.size() - 1);
+	return valid;
+}
+}	 // namespace
+
+auto shared_memory_resource_test0 = suite<"shared_memory_resource", "psl", "psl::memory">() = [] {
+	auto name = "/psl_shared_memory_resource_test";
+	using open_mode = shared_memory_resource::open_mode;
+
+	section<"header checks">() = [&] {
+		expect([&] { shared_memory_resource {8, name, open_mode::open}; }) == throws<>();
+		shared_memory_resource resource {8, name, open_mode::create, 1 << 16, 1};
+		expect(resource.size() % _priv::virtual_memory::page_size()) == 0u;
+		expect(resource.size() >= (1 << 16)) == true;
+		expect([&] { shared_memory_resource {8, name, open_mode::open, 0, 2}; }) == throws<>();
+		expect([&] { shared_memory_resource {_priv::virtual_memory::page_size() * 2, name, open_mode::open}; }) ==
+		  throws<>();
+		shared_memory_resource second {8, name, open_mode::open_or_create, 1 << 16, 1};
+		expect(second.size()) == resource.size();
+		expect(second.header().capacity) == resource.size();
+	};
+
+	section<"bookkeeping">() = [&] {
+		shared_memory_resource resource {16, name, open_mode::create, 1 << 20};
+		expect(resource.block_size(1, 1)) == 16u;
+		expect(resource.block_size(100, 16)) == 128u;
+		expect(resource.block_size(10, 256)) == 256u;
+
+		auto first	= resource.allocate(100, 16);
+		auto second = resource.allocate(300, 256);
+		expect((std::uintptr_t)first.data % 128) == 0u;
+		expect((std::uintptr_t)second.data % 256) == 0u;
+		expect((std::byte*)first.tail - (std::byte*)first.data) == 128;
+
+		// freed blocks are reused by the allocations of the same size class.
+		expect(resource.deallocate(first.data, 100, 16)) == true;
+		auto reuse = resource.allocate(120, 16);
+		expect(reuse.data) == first.data;
+		expect(resource.deallocate(reuse.data, 128, 16)) == true;
+
+		// a rooted allocation is only freed once both the root and the container released it.
+		resource.set_root(3, (std::byte const*)second.data, 300);
+		expect(resource.deallocate(second.data, 300, 256)) == true;
+		expect(resource.root<std::byte>(3).data()) == second.data;
+		auto other = resource.allocate(300, 256);
+		expect(other.data != second.data) == true;
+		resource.release_root(3);
+		expect(resource.root<std::byte>(3).empty()) == true;
+		auto released = resource.allocate(300, 256);
+		expect(released.data) == second.data;
+
+		// releasing the root first leaves the block to its container.
+		resource.set_root(4, (std::byte const*)released.data, 300);
+		resource.release_root(4);
+		expect(resource.allocate(300, 256).data != released.data) == true;
+		expect(resource.deallocate(released.data, 300, 256)) == true;
+		expect(resource.allocate(300, 256).data) == released.data;
+
+		int value {0};
+		expect(resource.deallocate(&value, sizeof(int), alignof(int))) == false;
+		expect(resource.allocate(1 << 21, 16)) == false;
+		expect([&] { resource.set_root(0, &value, 1); }) == throws<>();
+		expect([&] { resource.set_root(shared_memory_header_t::root_count, (int const*)other.data, 1); }) ==
+		  throws<>();
+	};
+
+	section<"threads">() = [&] {
+		shared_memory_resource resource {16, name, open_mode::create, 1 << 24};
+		std::vector<std::thread> threads {};
+		std::atomic<size_t> failures {0};
+		for(std::uint8_t i = 1; i <= 4; ++i)
+			threads.emplace_back([&, i] { failures += stress(resource, i, i) ? 0 : 1; });
+		for(auto& thread : threads) thread.join();
+		expect(failures.load()) == 0u;
+	};
+
+#if defined(__linux__) || defined(__APPLE__)
+	section<"processes">() = [&] {
+		shared_memory_resource resource {alignof(entry_t), name, open_mode::create, 1 << 24, table_layout};
+		{
+			table_t table {shared_allocator_t {&resource}};
+			fill(table, 10000, 3);
+			resource.set_root(0, &table[0], table.size());
+			// the table's storage is pinned by the root, so it survives the array.
+		}
+
+		// the child maps the object at another address, reads the parent's table, and publishes one of its own.
+		auto child = fork();
+		if(child == 0) {
+			bool valid {false};
+			try {
+				shared_memory_resource opened {alignof(entry_t), name, open_mode::open, 0, table_layout};
+				valid = verify(opened.root<entry_t>(0), 10000, 3);
+				table_t table {shared_allocator_t {&opened}};
+				fill(table, 5000, 7);
+				opened.set_root(1, &table[0], table.size());
+			} catch(...) {
+				valid = false;
+			}
+			_exit(valid ? 0 : 1);
+		}
+		int status {-1};
+		expect(child > 0) == true;
+		expect(waitpid(child, &status, 0)) == child;
+		expect(WIFEXITED(status) && WEXITSTATUS(status) == 0) == true;
+		expect(verify(resource.root<entry_t>(1), 5000, 7)) == true;
+
+		// both processes allocate from the object at the same time.
+		child = fork();
+		if(child == 0) {
+			bool valid {false};
+			try {
+				shared_memory_resource opened {alignof(entry_t), name, open_mode::open, 0, table_layout};
+				valid = stress(opened, 0xAA, 1);
+			} catch(...) {
+				valid = false;
+			}
+			_exit(valid ? 0 : 1);
+		}
+		expect(stress(resource, 0x55, 2)) == true;
+		expect(waitpid(child, &status, 0)) == child;
+		expect(WIFEXITED(status) && WEXITSTATUS(status) == 0) == true;
+		expect(verify(resource.root<entry_t>(0), 10000, 3)) == true;
+		resource.release_root(0);
+		resource.release_root(1);
+	};
+#endif
+};
@@ -0,0 +1,153 @@
+#include <array>
+#include <atomic>
+#include <numeric>
+#include <psl/memory/simulated_device_resource.hpp>
+#include <thread>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+using namespace std::chrono_literals;
+
+namespace {
+/**
+ * \brief Minimal eagerly started coroutine, that flags when it ran to completion.
+ */
+struct task_t {
+	struct promise_type {
+		task_t get_return_object() noexcept { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() noexcept {}
+	};
+};
+
+task_t round_trip(simulated_device_resource<>& device,
+				  std::array<int, 64> const& input,
+				  std::array<int, 64>& output,
+				  std::atomic<bool>& done) {
+	auto block = co_await device.allocate_async(sizeof(input), alignof(int));
+	co_await device.write_async(block.data, input.data(), sizeof(input));
+	co_await device.read_async(output.data(), block.data, sizeof(output));
+	co_await device.deallocate_async(block.data, sizeof(input), alignof(int));
+	done = true;
+}
+
+task_t synchronize_on_worker(simulated_device_resource<>& device, std::atomic<bool>& refused, std::atomic<bool>& done) {
+	co_await device.allocate_async(0, alignof(int));
+	try {
+		device.synchronize();
+	} catch(implementation_error const&) {
+		refused = true;
+	}
+	done = true;
+}
+}	 // namespace
+
+auto simulated_device_resource_test0 = suite<"simulated_device_resource", "psl", "psl::memory">() = [] {
+	static_assert(traits::IsAsyncAccessible<simulated_device_resource<>>);
+	static_assert(traits::HasTrait<simulated_device_resource<>,
+								   traits::host_readability_t<traits::syncronization::async>>);
+
+	section<"completion tokens">() = [] {
+		completion_source<int> source {};
+		auto token = source.token();
+		auto copy  = token;
+		expect(token.valid()) == true;
+		expect(completion_token<int> {}.valid()) == false;
+		expect(token.ready()) == false;
+		expect(token.wait_for(1ms)) == false;
+
+		std::thread producer {[&] { source.complete(42); }};
+		expect(copy.get()) == 42;
+		producer.join();
+		expect(token.ready()) == true;
+		expect([&] { source.complete(1); }) == throws<>();
+	};
+
+	section<"operations complete in order">() = [] {
+		simulated_device_resource<> device {alignof(int), 10ms};
+		std::array<int, 256> input {}, output {};
+		std::iota(input.begin(), input.end(), 0);
+
+		auto allocation = device.allocate_async(sizeof(input), alignof(int));
+		auto block		= allocation.get();
+		expect((bool)block) == true;
+		// every operation is queued before the first one completed, and they complete in order.
+		auto write = device.write_async(block.data, input.data(), sizeof(input));
+		auto read  = device.read_async(output.data(), block.data, sizeof(output));
+		auto free  = device.deallocate_async(block.data, sizeof(input), alignof(int));
+		expect(write.ready()) == false;
+		expect(free.get()) == true;
+		expect(write.ready() && read.ready()) == true;
+		expect(output == input) == true;
+	};
+
+	section<"transfers overlap with compute">() = [] {
+		simulated_device_resource<> device {alignof(int), 20ms};
+		std::vector<int> input(1 << 16), output(1 << 16);
+		std::iota(input.begin(), input.end(), 0);
+		auto block = device.allocate(input.size() * sizeof(int), alignof(int));
+
+		auto upload = device.write_async(block.data, input.data(), input.size() * sizeof(int));
+		// the host keeps computing while the transfer is in flight.
+		size_t sum {0};
+		for(auto value : input) sum += (size_t)value;
+		expect(upload.ready()) == false;
+		device.synchronize();
+		expect(upload.ready()) == true;
+
+		expect(device.read_async(output.data(), block.data, output.size() * sizeof(int)).get()) == true;
+		expect(output == input) == true;
+		expect(sum) == input.size() * (input.size() - 1) / 2;
+		expect(device.deallocate(block.data, input.size() * sizeof(int), alignof(int))) == true;
+	};
+
+	section<"coroutines">() = [] {
+		simulated_device_resource<> device {alignof(int), 100us};
+		std::array<int, 64> input {}, output {};
+		std::iota(input.begin(), input.end(), 7);
+		std::atomic<bool> done {false};
+		round_trip(device, input, output, done);
+		device.synchronize();
+		// the coroutine resumes on the worker, and queues its next operation behind the one `synchronize` waits on.
+		while(!done) std::this_thread::yield();
+		expect(output == input) == true;
+	};
+
+	if constexpr(config::implementation_exceptions) {
+		section<"synchronize from the worker">() = [] {
+			simulated_device_resource<> device {alignof(int)};
+			std::atomic<bool> refused {false}, done {false};
+			synchronize_on_worker(device, refused, done);
+			while(!done) std::this_thread::yield();
+			expect(refused.load()) == true;
+		};
+	}
+
+	section<"allocator interface">() = [] {
+		using device_allocator_t =
+		  allocator<traits::shareable_t<true>,
+					traits::basic_allocation,
+					traits::async_access_t,
+					traits::host_readability_t<traits::syncronization::async>,
+					traits::host_writability_t<traits::syncronization::async>>;
+		simulated_device_resource<> device {alignof(int)};
+		device_allocator_t allocator {&device};
+		std::array<float, 16> input {}, output {};
+		std::iota(input.begin(), input.end(), 1.0f);
+
+		alloc_results<void> allocation = allocator.allocate_async<float>(input.size()).get();
+		auto block					   = (alloc_results<float>)allocation;
+		expect((bool)block) == true;
+		expect(allocator.write_async(block.data, input.data(), input.size()).get()) == true;
+		expect(allocator.read_async(output.data(), block.data, output.size()).get()) == true;
+		expect(allocator.deallocate_async(block.data, input.size()).get()) == true;
+		expect(output == input) == true;
+	};
+};
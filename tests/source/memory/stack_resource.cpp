@@ -0,0 +1,86 @@
+#include <psl/array.hpp>
+#include <psl/memory/stack_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+namespace {
+using stack_allocator_t = psl::allocator<traits::shareable_t<false>, traits::basic_allocation>;
+}
+
+auto stack_resource_test0 = suite<"stack_resource", "psl", "psl::memory">() = [] {
+	alignas(16) std::byte buffer[1024];
+	stack_resource<> resource {alignof(int), buffer, sizeof(buffer)};
+
+	section<"both ends">() = [&] {
+		auto front = resource.front().allocate(100, 4);
+		expect((std::byte*)front.data) == &buffer[0];
+		auto back = resource.back().allocate(100, 16);
+		expect((std::uintptr_t)back.data % 16) == 0u;
+		expect(back.tail <= &buffer[0] + sizeof(buffer)) == true;
+		expect(resource.available()) == (size_t)((std::byte*)back.data - front.tail);
+
+		// the ends can't cross
+		expect((bool)resource.back().allocate(resource.available() + 1, 4)) == false;
+		expect((bool)resource.allocate(resource.available() + 1, 4)) == false;
+
+		// LIFO deallocation
+		resource.back().deallocate(back.data, 100, 16);
+		resource.deallocate(front.data, 100, 4);
+		expect(resource.available()) == sizeof(buffer);
+		resource.reset();
+		expect(resource.available()) == sizeof(buffer);
+	};
+
+	section<"over-aligned back allocations">() = [&] {
+		auto before = resource.available();
+		auto first	= resource.back().allocate(20, 64);
+		auto second = resource.back().allocate(4, 128);
+		auto third	= resource.back().allocate(12, 4);
+		expect((std::uintptr_t)first.data % 64) == 0u;
+		expect((std::uintptr_t)second.data % 128) == 0u;
+
+		// deallocating in LIFO order gives back the padding in front of every block.
+		resource.back().deallocate(third.data, 12, 4);
+		resource.back().deallocate(second.data, 4, 128);
+		auto again = resource.back().allocate(4, 128);
+		expect(again.data) == second.data;
+		resource.back().deallocate(again.data, again.size(), 128);
+		resource.back().deallocate(first.data, first.size(), 64);
+		expect(resource.available()) == before;
+	};
+
+	section<"markers">() = [&] {
+		auto persistent = resource.allocate(64, 4);
+		auto marker		= resource.marker(stack_end::back);
+		for(int i = 0; i < 4; ++i) expect((bool)resource.back().allocate(64, 4)) == true;
+		resource.rewind(marker);
+		expect(resource.available()) == sizeof(buffer) - 64;
+
+		{
+			auto scope = resource.scope();
+			for(int i = 0; i < 4; ++i) expect((bool)resource.allocate(64, 4)) == true;
+			expect(resource.available()) == sizeof(buffer) - 5 * 64;
+		}
+		expect(resource.available()) == sizeof(buffer) - 64;
+		expect(resource.allocate(4, 4).data) == (void*)&buffer[64];
+		resource.reset();
+		(void)persistent;
+	};
+
+	section<"scratch array">() = [&] {
+		auto scope = resource.scope(stack_end::back);
+		stack_allocator_t allocator {&resource.back()};
+		psl::array<int, psl::dynamic_extent, settings::array<stack_allocator_t>> scratch {allocator};
+		scratch.reserve(128);
+		for(int i = 0; i < 128; ++i) scratch.emplace_back(i);
+		expect((std::byte*)&scratch[0] >= &buffer[0]) == true;
+		expect((std::byte*)&scratch[127] < &buffer[0] + sizeof(buffer)) == true;
+		expect(scratch[127]) == 127;
+	};
+	expect(resource.available()) == sizeof(buffer);
+};
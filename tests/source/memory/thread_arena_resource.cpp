@@ -0,0 +1,95 @@
+#include <atomic>
+#include <psl/array.hpp>
+#include <psl/memory/thread_arena_resource.hpp>
+#include <thread>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+auto thread_arena_resource_test0 = suite<"thread_arena_resource", "psl", "psl::memory">() = [] {
+	thread_arena_resource<> resource {alignof(int)};
+
+	section<"reuses freed blocks">() = [&] {
+		auto first = resource.allocate(40, 8);
+		expect((bool)first) == true;
+		expect(first.size()) == 48u;
+		expect((std::uintptr_t)first.data % 8) == 0u;
+		resource.deallocate(first.data, 40, 8);
+		auto second = resource.allocate(48, 8);
+		expect(second.data) == first.data;
+		resource.deallocate(second.data, 48, 8);
+
+		auto aligned = resource.allocate(100, 64);
+		expect((std::uintptr_t)aligned.data % 64) == 0u;
+		resource.deallocate(aligned.data, 100, 64);
+	};
+
+	section<"remote frees return to the owner">() = [&] {
+		auto res = resource.allocate(64, 16);
+		std::thread {[&] {
+			// the block goes back to the owner's arena, not to this thread's.
+			resource.deallocate(res.data, 64, 16);
+			auto other = resource.allocate(64, 16);
+			expect(other.data != res.data) == true;
+			resource.deallocate(other.data, 64, 16);
+		}}.join();
+		// drained on the owner's next allocation.
+		auto again = resource.allocate(64, 16);
+		expect(again.data) == res.data;
+		resource.deallocate(again.data, 64, 16);
+	};
+
+	section<"arenas of exited threads are adopted">() = [&] {
+		auto arenas = resource.arena_count();
+		void* block {nullptr};
+		std::thread {[&] { block = resource.allocate(32, 16).data; }}.join();
+		expect(resource.arena_count()) == arenas + 1;
+
+		// freed into the orphaned arena, and handed out again by the thread that adopts it.
+		resource.deallocate(block, 32, 16);
+		std::thread {[&] {
+			auto res = resource.allocate(32, 16);
+			expect(res.data) == block;
+			resource.deallocate(res.data, 32, 16);
+		}}.join();
+		expect(resource.arena_count()) == arenas + 1;
+	};
+
+	section<"large allocations bypass the arenas">() = [&] {
+		auto res = resource.allocate(4096, 16);
+		expect((bool)res) == true;
+		expect(resource.deallocate(res.data, 4096, 16)) == true;
+	};
+
+	section<"producer consumer">() = [&] {
+		constexpr size_t count = 1 << 14;
+		std::vector<std::atomic<int*>> slots(count);
+		std::atomic<size_t> failures {0};
+		std::vector<std::thread> threads {};
+		for(size_t t = 0; t < 2; ++t) {
+			threads.emplace_back([&, t] {
+				config::default_allocator_t allocator {&resource};
+				for(size_t i = t; i < count; i += 2) slots[i] = construct<int>(allocator, (int)i).data;
+			});
+			threads.emplace_back([&, t] {
+				config::default_allocator_t allocator {&resource};
+				psl::array<int> scratch {allocator};
+				for(size_t i = t; i < count; i += 2) {
+					int* value {nullptr};
+					while((value = slots[i].load()) == nullptr) std::this_thread::yield();
+					if(*value != (int)i)
+						++failures;
+					destroy(allocator, *value);
+					scratch.emplace_back((int)i);
+				}
+			});
+		}
+		for(auto& thread : threads) thread.join();
+		expect(failures.load()) == 0u;
+	};
+};
@@ -0,0 +1,131 @@
+#include <atomic>
+#include <psl/array.hpp>
+#include <psl/memory/thread_cache_resource.hpp>
+#include <thread>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+namespace {
+/**
+ * \brief forwards to a `new_resource`, counting the allocations that reach it.
+ */
+class counting_resource final : public traited_memory_resource<traits::shareable_t<true>, traits::basic_allocation> {
+	using base_type = traited_memory_resource<traits::shareable_t<true>, traits::basic_allocation>;
+	friend struct _priv::resource_access;
+
+  public:
+	counting_resource() : base_type(1) {}
+
+	size_t allocations() const noexcept { return m_Allocations.load(std::memory_order_relaxed); }
+	void reset() noexcept { m_Allocations.store(0, std::memory_order_relaxed); }
+
+  private:
+	alloc_results<void> do_allocate(size_t size, size_t alignment) override {
+		m_Allocations.fetch_add(1, std::memory_order_relaxed);
+		return m_Upstream.allocate(size, alignment);
+	}
+
+	bool do_deallocate(void* ptr, size_t size, size_t alignment) override {
+		return m_Upstream.deallocate(ptr, size, alignment);
+	}
+
+	new_resource m_Upstream {1};
+	std::atomic<size_t> m_Allocations {0};
+};
+}	 // namespace
+
+auto thread_cache_resource_test0 = suite<"thread_cache_resource", "psl", "psl::memory">() = [] {
+	thread_cache_resource<> resource {alignof(int)};
+
+	section<"reuses freed blocks">() = [&] {
+		auto first = resource.allocate(40, 8);
+		expect((bool)first) == true;
+		expect(first.size()) == 48u;
+		resource.deallocate(first.data, 40, 8);
+		auto second = resource.allocate(48, 8);
+		expect(second.data) == first.data;
+		resource.deallocate(second.data, 48, 8);
+	};
+
+	section<"cross thread return">() = [&] {
+		auto res = resource.allocate(64, 16);
+		std::thread {[&] {
+			resource.deallocate(res.data, 64, 16);
+			auto again = resource.allocate(64, 16);
+			expect(again.data) == res.data;
+			resource.deallocate(again.data, 64, 16);
+		}}.join();
+		expect(resource.depot_size(64, 16) > 0u) == true;
+	};
+
+	section<"large allocations are cached in power of two classes">() = [&] {
+		auto first = resource.allocate(3000, 16);
+		expect((bool)first) == true;
+		expect(first.size()) == 4096u;
+		resource.deallocate(first.data, 3000, 16);
+		auto second = resource.allocate(4096, 16);
+		expect(second.data) == first.data;
+		resource.deallocate(second.data, second.size(), 16);
+
+		std::thread {[&] {
+			auto res = resource.allocate(4096, 16);
+			resource.deallocate(res.data, 4096, 16);
+		}}.join();
+		expect(resource.depot_size(4096, 16) > 0u) == true;
+	};
+
+	section<"growing arrays reuse the cached blocks">() = [&] {
+		counting_resource upstream {};
+		thread_cache_resource<counting_resource> cached {alignof(int), &upstream};
+		using array_t =
+		  psl::array<int, psl::dynamic_extent, settings::array<config::default_allocator_t, default_t, 0>>;
+		for(int round = 0; round < 2; ++round) {
+			array_t arr {config::default_allocator_t {&cached}};
+			for(int i = 0; i < 4096; ++i) arr.emplace_back(i);
+			expect(arr[4095]) == 4095;
+			if(round == 0)
+				upstream.reset();
+		}
+		expect(upstream.allocations()) == 0u;
+	};
+
+	section<"allocations beyond the cached size bypass the cache">() = [&] {
+		auto res = resource.allocate(decltype(resource)::max_cached_size + 1, 16);
+		expect((bool)res) == true;
+		expect(resource.deallocate(res.data, decltype(resource)::max_cached_size + 1, 16)) == true;
+		expect(resource.depot_size(decltype(resource)::max_cached_size + 1, 16)) == 0u;
+	};
+
+	section<"concurrent churn">() = [&] {
+		std::vector<std::thread> threads {};
+		std::atomic<size_t> failures {0};
+		for(size_t t = 0; t < 8; ++t) {
+			threads.emplace_back([&, t] {
+				config::default_allocator_t allocator {&resource};
+				std::vector<int*> nodes {};
+				for(int round = 0; round < 16; ++round) {
+					for(int i = 0; i < 256; ++i) nodes.emplace_back(construct<int>(allocator, i + (int)t).data);
+					for(int i = 0; i < 256; ++i)
+						if(*nodes[i] != i + (int)t)
+							++failures;
+					for(auto* node : nodes) destroy(allocator, *node);
+					nodes.clear();
+
+					psl::array<int> arr {allocator};
+					for(int i = 0; i < 512; ++i) arr.emplace_back(i);
+					for(int i = 0; i < 512; ++i)
+						if(arr[i] != i)
+							++failures;
+				}
+			});
+		}
+		for(auto& thread : threads) thread.join();
+		expect(failures.load()) == 0u;
+	};
+};
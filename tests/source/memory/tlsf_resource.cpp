@@ -0,0 +1,105 @@
+#include <psl/memory/tlsf_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace psl;
+using namespace litmus;
+
+auto tlsf_resource_test0 = suite<"tlsf_resource", "psl", "psl::memory">() = [] {
+	alignas(64) static std::byte buffer[1 << 16];
+	tlsf_resource<> resource {alignof(int), buffer, sizeof(buffer)};
+	static_assert(traits::IsSizeQueryable<tlsf_resource<>>);
+	static_assert(traits::IsPhysicallyAllocated<tlsf_resource<>>);
+
+	section<"allocate">() = [&] {
+		expect(resource.size()) == sizeof(buffer);
+		expect(resource.available()) == sizeof(buffer);
+
+		auto first = resource.allocate(100, 4);
+		expect((bool)first) == true;
+		expect(first.size()) == 112u;
+		auto second = resource.allocate(64, 256);
+		expect((std::uintptr_t)second.data % 256) == 0u;
+		std::fill_n((std::byte*)first.data, 100, std::byte {0xff});
+		std::fill_n((std::byte*)second.data, 64, std::byte {0xff});
+
+		resource.deallocate(first.data, 100, 4);
+		resource.deallocate(second.data, 64, 256);
+		expect(resource.available()) == sizeof(buffer);
+
+		// everything merged back into a single block
+		auto whole = resource.allocate(sizeof(buffer) - resource.granularity(), 4);
+		expect((bool)whole) == true;
+		resource.deallocate(whole.data, sizeof(buffer) - resource.granularity(), 4);
+	};
+
+	section<"exhaustion">() = [&] {
+		expect((bool)resource.allocate(sizeof(buffer), 4)) == false;
+
+		std::vector<alloc_results<void>> blocks {};
+		while(auto res = resource.allocate(1000, 4)) blocks.emplace_back(res);
+		expect(blocks.size()) == sizeof(buffer) / 1024;
+		for(auto& block : blocks) resource.deallocate(block.data, 1000, 4);
+		expect(resource.available()) == sizeof(buffer);
+	};
+
+	section<"random">() = [&] {
+		std::mt19937 rng {42};
+		std::vector<std::pair<alloc_results<void>, size_t>> live {};
+		for(size_t i = 0; i < 4096; ++i) {
+			if(!live.empty() && (rng() % 2 == 0 || live.size() > 32)) {
+				auto index = rng() % live.size();
+				auto [res, size] = live[index];
+				expect(std::all_of((std::byte*)res.data, (std::byte*)res.data + size, [size = size](auto value) {
+					return value == (std::byte)size;
+				})) == true;
+				resource.deallocate(res.data, size, 8);
+				live[index] = live.back();
+				live.pop_back();
+			} else {
+				auto size = 1 + rng() % 1024;
+				auto res  = resource.allocate(size, 8);
+				expect((bool)res) == true;
+				expect((std::uintptr_t)res.data % 8) == 0u;
+				std::fill_n((std::byte*)res.data, size, (std::byte)size);
+				live.emplace_back(res, size);
+			}
+		}
+		for(auto& [res, size] : live) resource.deallocate(res.data, size, 8);
+		expect(resource.available()) == sizeof(buffer);
+	};
+};
+
+auto tlsf_resource_test1 = suite<"tlsf_resource", "psl", "psl::memory">() = [] {
+	// simulated device heap, the region is never dereferenced.
+	tlsf_resource<false> resource {256, (void*)std::uintptr_t {0x10000}, 1 << 24, 256};
+	static_assert(traits::IsVirtuallyAllocated<tlsf_resource<false>>);
+
+	section<"bookkeeping only">() = [&] {
+		expect(resource.size()) == size_t {1 << 24};
+
+		auto first = resource.allocate(1000, 1);
+		expect((std::uintptr_t)first.data) == std::uintptr_t {0x10000};
+		expect(first.size()) == 1024u;
+		auto second = resource.allocate(1 << 16, 1 << 16);
+		expect((std::uintptr_t)second.data % (1 << 16)) == 0u;
+		auto third = resource.allocate(1, 1);
+		expect((std::uintptr_t)third.data) == std::uintptr_t {0x10000 + 1024};
+
+		resource.deallocate(second.data, 1 << 16, 1 << 16);
+		resource.deallocate(first.data, 1000, 1);
+		resource.deallocate(third.data, 1, 1);
+		expect(resource.available()) == size_t {1 << 24};
+	};
+
+	section<"foreign pointers">() = [&] {
+		int value {0};
+		expect(resource.deallocate(&value, sizeof(int), alignof(int))) == false;
+	};
+};
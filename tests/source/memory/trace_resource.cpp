@@ -0,0 +1,86 @@
+#include <filesystem>
+#include <psl/memory/trace_resource.hpp>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+auto trace_resource_test0 = suite<"trace_resource", "psl", "psl::memory">() = [] {
+	auto path = (std::filesystem::temp_directory_path() / "psl_trace_resource_test.trace").string();
+
+	section<"records">() = [&] {
+		{
+			trace_resource<> resource {alignof(int), path.c_str()};
+			auto first	= resource.allocate(24, 8);
+			auto second = resource.allocate(100, 4);
+			resource.deallocate(first.data, 24, 8);
+			resource.deallocate(second.data, 100, 4);
+			expect(resource.recorded()) == 4u;
+			resource.flush();
+
+			auto events = read_trace(path.c_str());
+			expect(events.size()) == 4u;
+			expect(events[0].operation) == trace_operation::allocate;
+			expect(events[0].address) == (std::uint64_t)(std::uintptr_t)first.data;
+			expect(events[0].size) == 24u;
+			expect(events[0].alignment) == 8u;
+			expect(events[1].size) == 100u;
+			expect(events[1].alignment) == 4u;
+			expect(events[2].operation) == trace_operation::deallocate;
+			expect(events[2].address) == events[0].address;
+			expect(events[3].address) == events[1].address;
+			for(size_t i = 1; i < events.size(); ++i) expect(events[i - 1].timestamp <= events[i].timestamp) == true;
+		}
+		std::filesystem::remove(path);
+	};
+
+	section<"threads">() = [&] {
+		constexpr size_t threads	= 4;
+		constexpr size_t iterations = trace_resource<>::buffer_size * 3 + 17;
+		{
+			trace_resource<> resource {alignof(int), path.c_str()};
+			std::vector<std::thread> workers {};
+			for(size_t t = 0; t < threads; ++t) {
+				workers.emplace_back([&] {
+					config::default_allocator_t allocator {&resource};
+					for(size_t i = 0; i < iterations; ++i) {
+						auto res = allocator.allocate<std::uint64_t>();
+						allocator.deallocate(res.data);
+					}
+				});
+			}
+			for(auto& worker : workers) worker.join();
+		}
+
+		auto events = read_trace(path.c_str());
+		expect(events.size()) == threads * iterations * 2;
+		std::unordered_map<std::uint16_t, size_t> per_thread {};
+		std::unordered_map<std::uint64_t, size_t> live {};
+		size_t invalid {0};
+		for(auto const& event : events) {
+			++per_thread[event.thread];
+			if(event.operation == trace_operation::allocate)
+				++live[event.address];
+			else if(event.operation == trace_operation::deallocate && live[event.address]-- == 0)
+				++invalid;
+		}
+		expect(per_thread.size()) == threads;
+		expect(invalid) == 0u;
+		std::filesystem::remove(path);
+	};
+
+	section<"rejects foreign files">() = [&] {
+		{
+			std::unique_ptr<std::FILE, int (*)(std::FILE*)> file {std::fopen(path.c_str(), "wb"), &std::fclose};
+			std::fputs("not a trace at all", file.get());
+		}
+		expect([&] { read_trace(path.c_str()); }) == throws<>();
+		std::filesystem::remove(path);
+	};
+};
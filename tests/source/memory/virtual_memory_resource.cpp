@@ -0,0 +1,82 @@
+#include <psl/array.hpp>
+#include <psl/memory/virtual_memory_resource.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+
+using namespace psl;
+using namespace litmus;
+
+namespace {
+using virtual_memory_allocator_t =
+  psl::allocator<traits::shareable_t<false>, traits::basic_allocation, traits::reallocate_able_t>;
+}
+
+auto virtual_memory_resource_test0 = suite<"virtual_memory_resource", "psl", "psl::memory">() = [] {
+	virtual_memory_resource resource {alignof(int), size_t {1} << 30};
+	auto page = resource.page_size();
+
+	section<"allocate">() = [&] {
+		expect(resource.committed()) == 0u;
+		auto first = resource.allocate(100, 4);
+		expect((bool)first) == true;
+		expect((std::uintptr_t)first.data % page) == 0u;
+		expect(first.size()) == page;
+		std::fill_n((std::byte*)first.data, first.size(), std::byte {0xff});
+		expect(resource.committed()) == page;
+
+		auto second = resource.allocate(page + 1, 4);
+		expect((std::byte*)second.data) == first.tail;
+		expect(second.size()) == 2 * page;
+		expect(resource.committed()) == 3 * page;
+
+		resource.deallocate(second.data, page + 1, 4);
+		expect(resource.committed()) == page;
+		resource.reset();
+		expect(resource.committed()) == 0u;
+	};
+
+	section<"reallocate in place">() = [&] {
+		auto block = resource.allocate(page, 4);
+		std::fill_n((std::byte*)block.data, page, std::byte {0x11});
+
+		auto grown = resource.reallocate(block.data, 1, 64 * page, 4);
+		expect(grown.data) == block.data;
+		expect(grown.size()) == 64 * page;
+		expect(((std::byte*)grown.data)[page - 1]) == std::byte {0x11};
+		((std::byte*)grown.data)[64 * page - 1] = std::byte {0x22};
+
+		auto shrunk = resource.reallocate(grown.data, 1, 1, 4);
+		expect(shrunk.data) == block.data;
+		expect(shrunk.size()) == page;
+		expect(resource.committed()) == page;
+
+		expect((bool)resource.reallocate(block.data, 1, resource.capacity() + 1, 4)) == false;
+		resource.reset();
+	};
+
+	section<"array never relocates">() = [&] {
+		virtual_memory_allocator_t allocator {&resource};
+		psl::array<int, psl::dynamic_extent, settings::array<virtual_memory_allocator_t>> arr {allocator};
+		arr.reserve(1024);
+		auto* data = &arr[0];
+		for(int i = 0; i < (1 << 20); ++i) arr.emplace_back(i);
+		expect(&arr[0]) == data;
+		for(int i = 0; i < (1 << 20); i += 4096) expect(arr[i]) == i;
+	};
+
+	section<"shrink_to_fit decommits">() = [&] {
+		virtual_memory_allocator_t allocator {&resource};
+		psl::array<int, psl::dynamic_extent, settings::array<virtual_memory_allocator_t>> arr {allocator};
+		arr.reserve(1 << 20);
+		for(int i = 0; i < 1024; ++i) arr.emplace_back(i);
+		auto* data = &arr[0];
+		expect(resource.committed() >= (1 << 20) * sizeof(int)) == true;
+
+		arr.shrink_to_fit();
+		expect(&arr[0]) == data;
+		expect(resource.committed()) == psl::align_to<size_t>(1024 * sizeof(int), page);
+		for(int i = 0; i < 1024; ++i) expect(arr[i]) == i;
+	};
+};